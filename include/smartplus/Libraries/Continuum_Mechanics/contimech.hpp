@@ -36,6 +36,9 @@ double Mises_stress(const arma::vec &);
 //This function determines the strain flow (direction) from a stress tensor, according to the Voigt convention for strains
 arma::vec eta_stress(const arma::vec &);
 
+//Same as above, the direction is written in the second argument (for instance a vec6) so that no temporary is allocated
+void eta_stress(const arma::vec &, arma::vec &);
+
 //This function determines the Mises equivalent of a strain tensor, according to the Voigt convention for strains 
 double Mises_strain(const arma::vec &);
 
@@ -0,0 +1,35 @@
+/* This file is part of SMART+.
+ 
+ SMART+ is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ SMART+ is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with SMART+.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+
+
+///@file voigt.hpp
+///@brief Fixed-size types for second and fourth order tensors written in Voigt notation
+///@brief Their storage lives inside the object, so they do not allocate on the heap
+///@version 1.0
+
+#pragma once
+#include <armadillo>
+
+namespace smart{
+
+//Second order tensor (stress, strain) in Voigt notation
+typedef arma::vec::fixed<6> vec6;
+
+//Fourth order tensor (stiffness, compliance, concentration tensor) in Voigt notation
+typedef arma::mat::fixed<6,6> mat66;
+
+} //namespace smart
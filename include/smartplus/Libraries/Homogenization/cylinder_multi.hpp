@@ -25,6 +25,7 @@
 #include <string>
 #include <armadillo>
 #include <smartplus/Libraries/Geometry/cylinder.hpp>
+#include <smartplus/Libraries/Maths/rotation_operators.hpp>
 #include <smartplus/Libraries/Phase/phase_characteristics.hpp>
 #include "phase_multi.hpp"
 
@@ -40,17 +41,24 @@ protected:
     
 	public :
 
+    arma::mat S_loc;
     arma::mat T_loc;
     arma::mat T;
     
     arma::mat A_loc;
     arma::mat B_loc;
     
+    rotation_operators rot_geom;  //cached rotation operators of the geometric orientation of the cylinder
+    
     cylinder_multi(); //default constructor
     cylinder_multi(const arma::mat&, const arma::mat&, const arma::mat&, const arma::mat&, const arma::mat&, const arma::mat&, const arma::mat&, const arma::mat&); //Constructor with parameters
     cylinder_multi(const cylinder_multi&);	//Copy constructor
     ~cylinder_multi();
     
+    //The cylinder is infinite along its local axis 1: its Eshelby tensor is the closed-form one of Eshelby_cylinder, with the Poisson ratio of the (isotropic part of the) matrix
+    virtual void fillS_loc(const arma::mat&, const cylinder &); //need the L_global of the matrix
+    virtual void fillT(const arma::mat&, const arma::mat&, const cylinder &); //need the L_global of the matrix
+    
 //    virtual void l2g_T();
 //    virtual void g2l_T();
     
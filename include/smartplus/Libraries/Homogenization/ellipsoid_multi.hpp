@@ -25,6 +25,8 @@
 #include <string>
 #include <armadillo>
 #include "../Geometry/ellipsoid.hpp"
+#include "../Maths/rotation_operators.hpp"
+#include "eshelby.hpp"
 #include "phase_multi.hpp"
 
 namespace smart{
@@ -44,12 +46,9 @@ protected:
     arma::mat T_loc;
     arma::mat T;
     
-    static int mp;
-    static int np;
-    static arma::vec x;
-    static arma::vec wx;
-    static arma::vec y;
-    static arma::vec wy;
+    rotation_operators rot_geom;  //cached rotation operators of the geometric orientation of the ellipsoid
+    
+    std::shared_ptr<const Gauss_points> gauss;   //integration points of the Eshelby and Hill tensors, shared read-only between the phases (see get_Gauss_points)
     
     ellipsoid_multi(); //default constructor
     ellipsoid_multi(const arma::mat&, const arma::mat&, const arma::mat&, const arma::mat&, const arma::mat&, const arma::mat&, const arma::mat&, const arma::mat&); //Constructor with parameters
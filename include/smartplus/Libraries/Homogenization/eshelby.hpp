@@ -23,11 +23,26 @@
 #pragma once
 
 #include <math.h>
+#include <memory>
 #include <armadillo>
 #include "../../parameter.hpp"
 
 namespace smart{
 
+//Integration points and weights of the numerical Eshelby and Hill tensors, for mp points in the 1 direction and np points in the 2 direction
+struct Gauss_points
+{
+    int mp;
+    int np;
+    arma::vec x;
+    arma::vec wx;
+    arma::vec y;
+    arma::vec wy;
+};
+
+//Returns the table of integration points for (mp, np). The tables are built once by points() and shared read-only, this function is thread-safe
+std::shared_ptr<const Gauss_points> get_Gauss_points(const int &, const int &);
+    
 //Eshelby tensor for a sphere
 arma::mat Eshelby_sphere(const double &);
 
@@ -40,17 +55,24 @@ arma::mat Eshelby_prolate(const double &, const double &);
 //	Eshelby tensor determination. The oblate shape is oriented in such a way that the axis direction is the 1 direction. a1<a2=a3 here
 arma::mat Eshelby_oblate(const double &, const double &);
 
+//Closed-form Eshelby tensor if the matrix is isotropic (relative distance to its isotropic projection L_iso_props below eshelby_iso_tol, see parameter.hpp) and the inclusion is a sphere or a spheroid of axis 1 (a2=a3).
+//Returns false, and leaves the tensor untouched, otherwise
+bool Eshelby_closed_form(const arma::mat &, const double &, const double &, const double &, arma::mat &);
+
 //This methods is using the Voigt notations for the tensors.
 void calG(const double &, const double &, const double &, const double &, const double &, const arma::Mat<int> &, const arma::mat &, arma::mat &);
 
-//Weighted Gauss integration over a sphere to represent the integration over the ellipsoid
-void Gauss(arma::Mat<int> &, const arma::mat &, arma::mat &, const double &, const double &, const double &, const arma::vec &, const arma::vec &, const arma::vec &, const arma::vec &, const int &, const int &);
+//Weighted Gauss integration over a sphere to represent the integration over the ellipsoid. The integrand (same as calG) is evaluated for all the points of a given x3 at once
+void Gauss(const arma::mat &, arma::mat &, const double &, const double &, const double &, const arma::vec &, const arma::vec &, const arma::vec &, const arma::vec &, const int &, const int &);
 
 //Numerical Eshelby tensor determination
 arma::mat Eshelby(const arma::mat &, const double &, const double &, const double &, const arma::vec &, const arma::vec &, const arma::vec &, const arma::vec &, const int &mp, const int &np);
 
 //Numerical Eshelby tensor determination
 arma::mat Eshelby(const arma::mat &, const double &, const double &, const double &, const int &, const int &);
+
+//Numerical Eshelby tensor determination, with a table of integration points
+arma::mat Eshelby(const arma::mat &, const double &, const double &, const double &, const Gauss_points &);
     
 //arma::mat T_II_sphere(const double &, const double &); {
 
@@ -59,6 +81,19 @@ arma::mat T_II(const arma::mat &, const double &, const double &, const double &
 
 //Numerical Hill Interaction tensor determination
 arma::mat T_II(const arma::mat &, const double &, const double &, const double &, const int &, const int &);
+
+//Numerical Hill Interaction tensor determination, with a table of integration points
+arma::mat T_II(const arma::mat &, const double &, const double &, const double &, const Gauss_points &);
+
+//Eshelby tensor, memoized on (Lt, a1, a2, a3, mp, np) and computed on a miss in closed form when possible (see Eshelby_closed_form), numerically otherwise: a hit skips the computation (see eshelby_cache_size and eshelby_cache_tol in parameter.hpp). This function is thread-safe
+//The last argument is the relative tolerance to reuse a cached tensor (0 for an exact match)
+arma::mat Eshelby_cached(const arma::mat &, const double &, const double &, const double &, const Gauss_points &, const double & = eshelby_cache_tol);
+
+//Numerical Hill Interaction tensor, memoized the same way
+arma::mat T_II_cached(const arma::mat &, const double &, const double &, const double &, const Gauss_points &, const double & = eshelby_cache_tol);
+
+//Number of calls of Eshelby_cached and T_II_cached that had to compute the tensor (cache misses)
+unsigned long Eshelby_cache_misses();
     
 //This function computes the integration points and weights
 void points(arma::vec &, arma::vec &, arma::vec &, arma::vec &, const int &, const int &);
@@ -24,6 +24,8 @@
 #include <iostream>
 #include <string>
 #include <armadillo>
+#include "../Geometry/layer.hpp"
+#include "../Maths/rotation_operators.hpp"
 #include "phase_multi.hpp"
 
 namespace smart{
@@ -46,6 +48,8 @@ class layer_multi : public phase_multi
         //Part of the tangent modulus (usefull derivative)
         arma::mat Dnn;
         arma::mat Dnt;
+        arma::mat inv_Dnn;
+        arma::mat Lt_D;     //global tangent modulus from which Dnn, Dnt and inv_Dnn have been computed
         //Derivatives of the gradient / x1
         arma::mat dXn;
         arma::mat dXt;
@@ -54,11 +58,16 @@ class layer_multi : public phase_multi
         arma::vec sigma_hat;
         arma::vec dzdx1;
     
+        rotation_operators rot_geom;  //cached rotation operators of the geometric orientation of the layer
+    
         layer_multi(); 	//default constructor
         layer_multi(const arma::mat&, const arma::mat&, const arma::mat&, const arma::mat&, const arma::mat&, const arma::mat&, const arma::mat&, const arma::mat&, const arma::vec&, const arma::vec&); //Constructor with parameters
         layer_multi(const layer_multi&);	//Copy constructor
             ~layer_multi();
     
+        //Dnn, Dnt and inv(Dnn) in the coordinate system of the layer. They are kept as long as the tangent modulus does not change (elastic layers)
+        virtual void fillD(const arma::mat&, const layer &);
+    
         virtual layer_multi& operator = (const layer_multi&);
         
         friend std::ostream& operator << (std::ostream&, const layer_multi&);
@@ -43,6 +43,8 @@ class phase_multi
 		arma::mat A_start;	//Concentration tensor (strain)
 		arma::mat B;	//Concentration tensor (stress)
 		arma::mat B_start;	//Concentration tensor (stress)
+        int nbiter;     //Number of iterations of the localization loop at the last call, when the phase is itself a multiphase material
+        int nbiter_self_consistent;     //Number of passes of the inner fixed point of the self-consistent scheme at its last call, when the phase is itself a multiphase material
         
 		phase_multi(); 	//default constructor
         phase_multi(const arma::mat&, const arma::mat&, const arma::mat&, const arma::mat&); //Constructor with parameters
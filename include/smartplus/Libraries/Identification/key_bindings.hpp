@@ -0,0 +1,80 @@
+/* This file is part of SMART+.
+ 
+ SMART+ is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ SMART+ is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with SMART+.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+
+///@file key_bindings.hpp
+///@brief Binding of the parameters and constants of an identification to the material properties and the loading paths
+///@version 1.0
+
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <utility>
+#include <armadillo>
+#include "parameters.hpp"
+#include "constants.hpp"
+#include "../Solver/block.hpp"
+#include "../Solver/output.hpp"
+#include "../Solver/solver_context.hpp"
+
+namespace smart{
+
+//======================================
+class key_bindings
+//======================================
+{
+	private:
+
+	protected:
+
+	public :
+    
+        bool in_memory;     //true if all the keys have been bound, false if the keys have to be substituted in the files
+    
+        std::string umat_name;
+        int nstatev;
+        double psi_rve;
+        double theta_rve;
+        double phi_rve;
+        arma::vec props;    //material properties, the bound slots are replaced at each simulation
+    
+        std::vector<std::pair<int,int> > props_params;     //(slot in props, number of the parameter)
+        std::vector<std::pair<int,int> > props_consts;     //(slot in props, number of the constant)
+    
+        std::vector<std::vector<block> > blocks;   //loading path of each test file, with the constants of the test applied
+        arma::vec T_init;                           //initial temperature of each test file
+        std::vector<solver_output> so;              //output parameters of each test file
+        std::vector<solver_context> contexts;       //context of the runs of each test file, with the results kept in memory
+    
+		key_bindings(); 	//default constructor
+		key_bindings(const key_bindings &);	//Copy constructor (the steps of the blocks are shared)
+		~key_bindings();
+    
+        //Bind the keys of the parameters and constants to the slots of props (keys of the material file), and read the loading path of each test with its constants (keys of the files path_id_[i].txt).
+        //If a key appears in another file or within a longer token, in_memory is false and the simulations shall use the substitution of the keys in the files.
+        void bind(const std::vector<parameters> &, const std::vector<constants> &, const int &, const std::string &, const std::string &, const std::string &);
+    
+        //Material properties of an individual (values of its parameters) for the test file i
+        arma::vec material_props(const arma::vec &, const std::vector<constants> &, const int &) const;
+				
+		virtual key_bindings& operator = (const key_bindings&);
+		
+        friend  std::ostream& operator << (std::ostream&, const key_bindings&);
+};
+
+} //namespace smart
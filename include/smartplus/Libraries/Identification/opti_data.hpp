@@ -56,6 +56,7 @@ class opti_data
 		void constructdata();
 
         void import(std::string, int=0);
+        void import(const arma::mat &, int=0);     //Same import from the records of a run kept in memory (see solver_results), that have the columns of the result files
 				
 		virtual opti_data& operator = (const opti_data&);
 		
@@ -28,6 +28,7 @@
 #include "opti_data.hpp"
 #include "individual.hpp"
 #include "generation.hpp"
+#include "key_bindings.hpp"
 
 namespace smart{
 
@@ -44,13 +45,33 @@ void apply_parameters(const std::vector<parameters> &, const std::string &);
 void apply_constants(const std::vector<constants> &, const std::string &);
     
 //Read the control parameters of the optimization algorithm
-void launch_solver(const generation &, const int &, std::vector<parameters> &, std::vector<constants> &, const std::string &, const std::string &, const std::string &, const std::string &, const std::string&);
+void launch_solver(const individual &, const int &, std::vector<parameters> &, std::vector<constants> &, const std::string &, const std::string &, const std::string &, const std::string &, const std::string&);
     
-void run_simulation(const std::string &, const individual &, const int &, std::vector<parameters> &, std::vector<constants> &, std::vector<opti_data> &, const std::string &, const std::string &, const std::string &, const std::string &, const std::string&);
+//Same as launch_solver, with the parameters and constants patched in memory (see key_bindings)
+void launch_solver(const individual &, const int &, const std::vector<constants> &, key_bindings &, const std::string &, const std::string &);
+    
+//Same as launch_solver, with the results kept in memory (see solver_context) and imported in the numerical data: no file is written
+void launch_solver(const individual &, const int &, const std::vector<constants> &, key_bindings &, std::vector<opti_data> &);
+    
+//If key bindings are given and all the keys are bound, the simulations are run without the substitution of the keys in the files, and without result files if memory_results_identification == 1
+void run_simulation(const std::string &, const individual &, const int &, std::vector<parameters> &, std::vector<constants> &, std::vector<opti_data> &, const std::string &, const std::string &, const std::string &, const std::string &, const std::string&, key_bindings * = nullptr);
+    
+//Number of workers of run_simulations: nthreads_identification, or 1 if a key is substituted in a microstructure file (Nphases, Nlayers, Nellipsoids or Ncylinders), since the multiphase laws always read these files in data/
+int identification_workers(const std::vector<parameters> &, const std::vector<constants> &);
+    
+//Prepare the workers of run_simulations and bind their keys (see key_bindings), once for the whole identification.
+//With more than one worker, each worker has its own copy of the data folder (path_data_[worker]), removed by remove_workers.
+std::vector<key_bindings> bind_workers(const int &, const std::vector<parameters> &, const std::vector<constants> &, const int &, const std::string &, const std::string &, const std::string &);
+    
+void remove_workers(const int &, const std::string &);
+    
+//Run the simulations of all the individuals of a generation and return their numerical vectors (see calcV), in the order of the individuals.
+//The workers are the ones given by bind_workers: each worker runs its share of the individuals in its data folder and its own results folder (folder/results_[worker]).
+std::vector<arma::vec> run_simulations(const std::string &, const generation &, const int &, const std::vector<parameters> &, const std::vector<constants> &, const std::vector<opti_data> &, const std::vector<opti_data> &, const std::string &, const std::string &, const std::string &, const std::string &, const std::string&, const int &, std::vector<key_bindings> &);
     
 double calc_cost(const arma::vec &, arma::vec &, const arma::vec &, const std::vector<opti_data> &, const std::vector<opti_data> &, const int &, const int &);
 
-arma::mat calc_sensi(const individual &, generation &, const std::string &, const int &, const int &, std::vector<parameters> &, std::vector<constants> &, arma::vec &, std::vector<opti_data> &, std::vector<opti_data> &, const std::string &, const std::string &, const std::string &, const std::string &, const int &, const arma::vec &, const std::string&);
+arma::mat calc_sensi(const individual &, generation &, const std::string &, const int &, const int &, std::vector<parameters> &, std::vector<constants> &, arma::vec &, std::vector<opti_data> &, std::vector<opti_data> &, const std::string &, const std::string &, const std::string &, const std::string &, const int &, const arma::vec &, const std::string&, std::vector<key_bindings> &);
 
     
 } //namespace smart
@@ -0,0 +1,55 @@
+/* This file is part of SMART+.
+ 
+ SMART+ is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ SMART+ is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with SMART+.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+///@file anderson.hpp
+///@brief Anderson acceleration of a fixed-point iteration x = G(x)
+///@version 1.0
+
+#pragma once
+
+#include <iostream>
+#include <armadillo>
+
+namespace smart{
+
+//======================================
+class Anderson_mixing
+//======================================
+{
+	private:
+
+	protected:
+
+	public :
+
+        int depth;          //Maximal number of previous iterates used for the mixing (0 gives the plain fixed-point iteration)
+        int nhist;          //Number of differences currently stored
+        arma::mat dF;       //Differences of the successive residuals f = G(x) - x, one per column
+        arma::mat dG;       //Differences of the successive images G(x), one per column
+        arma::vec f_prev;   //Residual of the previous iterate
+        arma::vec g_prev;   //Image of the previous iterate
+    
+		Anderson_mixing(const int & = 5); 	//default constructor, with the depth of the history
+    
+        virtual ~Anderson_mixing();
+    
+        virtual void reset();  //Forget the history, the next iterate is the plain fixed-point one
+        virtual arma::vec update(const arma::vec &, const arma::vec &);   //Next iterate from the current iterate x and its image G(x)
+    
+        friend std::ostream& operator << (std::ostream&, const Anderson_mixing&);
+};
+
+} //namespace smart
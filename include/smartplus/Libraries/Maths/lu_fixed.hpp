@@ -0,0 +1,58 @@
+/* This file is part of SMART+.
+ 
+ SMART+ is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ SMART+ is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with SMART+.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+
+///@file lu_fixed.hpp
+///@brief LU decomposition of small linear systems of fixed size, on stack storage
+///@version 1.0
+
+#pragma once
+
+#include <iostream>
+#include <armadillo>
+
+namespace smart{
+
+//======================================
+template<int N> class LU_fixed
+//======================================
+{
+	private:
+
+	protected:
+
+	public :
+    
+        double a[N*N];      //Matrix of the system (row-major), replaced by its LU factors by factorize()
+        int piv[N];         //Row permutation of the partial pivoting
+        bool factorized;    //true if a holds the LU factors
+    
+		LU_fixed(); 	//default constructor
+    
+        double & operator () (const int &i, const int &j) { return a[i*N+j]; }
+        const double & operator () (const int &i, const int &j) const { return a[i*N+j]; }
+    
+        void zeros();       //Zero matrix, not factorized
+        bool factorize();   //LU decomposition with partial pivoting, in place. Returns false on a zero pivot (singular matrix)
+        void solve(const arma::vec &, arma::vec &) const;   //Solution x of the factorized system A x = b (the vectors have at least N elements and may be the same)
+    
+        friend std::ostream& operator << (std::ostream& s, const LU_fixed& lu) {
+            s << "LU_fixed<" << N << ">, factorized: " << lu.factorized << "\n";
+            return s;
+        }
+};
+
+} //namespace smart
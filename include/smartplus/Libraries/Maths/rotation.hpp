@@ -31,10 +31,12 @@ arma::mat fillR(const double &, const int &);
 //To generate a 6x6 rotation matrix for stress tensors
 arma::mat fillQS(const double &, const int &);
 arma::mat fillQS(const arma::mat &);
+void fillQS(arma::mat &, const arma::mat &);   //Same as above, written in the first argument (a mat66 avoids the allocation)
     
 //To generate a 6x6 rotation matrix for strain tensors
 arma::mat fillQE(const double &, const int &);
 arma::mat fillQE(const arma::mat &);
+void fillQE(arma::mat &, const arma::mat &);   //Same as above, written in the first argument (a mat66 avoids the allocation)
 
 //To rotate a stiffness matrix (6,6)
 arma::mat rotateL(const arma::mat &, const double &, const int &);
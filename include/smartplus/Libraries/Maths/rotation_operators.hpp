@@ -0,0 +1,73 @@
+/* This file is part of SMART+.
+ 
+ SMART+ is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ SMART+ is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with SMART+.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+
+///@file rotation_operators.hpp
+///@brief Composed rotation operators of a set of Euler angles (psi, theta, phi), computed once and reused
+///@version 1.0
+
+#pragma once
+
+#include <iostream>
+#include <armadillo>
+#include "../Continuum_Mechanics/voigt.hpp"
+
+namespace smart{
+
+//======================================
+class rotation_operators
+//======================================
+{
+	private:
+
+	protected:
+
+	public :
+
+        double psi;
+        double theta;
+        double phi;
+        bool identity;  //true if all the angles are below iota
+    
+        mat66 QS_g2l;   //global to local rotation of a stress vector, i.e. fillQS(phi)*fillQS(theta)*fillQS(psi)
+        mat66 QE_g2l;   //global to local rotation of a strain vector
+        mat66 QS_l2g;   //local to global rotation of a stress vector, inverse of QS_g2l (=trans(QE_g2l))
+        mat66 QE_l2g;   //local to global rotation of a strain vector, inverse of QE_g2l (=trans(QS_g2l))
+    
+		rotation_operators(); 	//default constructor, the operators are computed at the first call of update
+        rotation_operators(const double &, const double &, const double &);
+
+		rotation_operators(const rotation_operators&);	//Copy constructor
+        virtual ~rotation_operators();
+    
+        virtual void update(const double &, const double &, const double &);    //Recompute the operators only if the angles have changed
+    
+        //Rotations of (6,6) operators, equivalent to the rotate_g2l_X and rotate_l2g_X functions of rotation.hpp
+        virtual arma::mat g2l_L(const arma::mat &) const;
+        virtual arma::mat l2g_L(const arma::mat &) const;
+        virtual arma::mat g2l_M(const arma::mat &) const;
+        virtual arma::mat l2g_M(const arma::mat &) const;
+        virtual arma::mat g2l_A(const arma::mat &) const;
+        virtual arma::mat l2g_A(const arma::mat &) const;
+        virtual arma::mat g2l_B(const arma::mat &) const;
+        virtual arma::mat l2g_B(const arma::mat &) const;
+    
+		virtual rotation_operators& operator = (const rotation_operators&);
+		
+        friend std::ostream& operator << (std::ostream&, const rotation_operators&);
+};
+
+} //namespace smart
@@ -27,6 +27,7 @@
 #include <iostream>
 #include <string>
 #include <armadillo>
+#include "../Maths/rotation_operators.hpp"
 
 namespace smart{
 
@@ -42,10 +43,12 @@ class material_characteristics
 
 		int number;
         std::string umat_name;
+        int umat_id;    //id of the constitutive law, resolved from umat_name in update (see umat_registry.hpp)
         int save;   //If the restults of this material being saved or not
         double psi_mat;
         double theta_mat;
         double phi_mat;
+        rotation_operators rot_mat;    //cached rotation operators of (psi_mat, theta_mat, phi_mat), refreshed by update_rotation
         
 		int nprops;
 		arma::vec props;
@@ -62,6 +65,7 @@ class material_characteristics
 		virtual void resize(const int &, const bool & = true, const double & = 0.);
 		virtual void update(const int &, const std::string &, const int &, const double &, const double &, const double &, const int &, const arma::vec &);
 		virtual int dimprops () const {return nprops;}       // returns the number of props, nprops
+        virtual const rotation_operators& update_rotation();    //recompute rot_mat if the angles have changed
     
 		virtual material_characteristics& operator = (const material_characteristics&);
 		
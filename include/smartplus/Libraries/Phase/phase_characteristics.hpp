@@ -24,12 +24,14 @@
 
 #include <iostream>
 #include <string>
+#include <assert.h>
 #include <armadillo>
 #include "../Geometry/geometry.hpp"
 #include "../Homogenization/phase_multi.hpp"
 #include "material_characteristics.hpp"
 #include "state_variables.hpp"
 #include "../Solver/output.hpp"
+#include "../Solver/output_writer.hpp"
 
 namespace smart{
 
@@ -52,6 +54,7 @@ class phase_characteristics
         std::shared_ptr<state_variables> sptr_sv_local;
         std::shared_ptr<std::ofstream> sptr_out_global;
         std::shared_ptr<std::ofstream> sptr_out_local;
+        std::shared_ptr<output_writer> sptr_writer;    //if defined, the records are written by its thread
     
         std::vector<phase_characteristics> sub_phases;
         std::string sub_phases_file;
@@ -63,7 +66,7 @@ class phase_characteristics
 		phase_characteristics(const phase_characteristics&);	//Copy constructor
         virtual ~phase_characteristics();
     
-        virtual void construct(const int &, const int &);
+        virtual void construct(const int &, const int &, const bool & = true);
         virtual void sub_phases_construct(const int &, const int &, const int &);
         virtual void to_start();
         virtual void set_start();
@@ -73,11 +76,57 @@ class phase_characteristics
 
 		virtual phase_characteristics& operator = (const phase_characteristics&);
     
-        virtual void define_output(const std::string &, const std::string & = "results", const std::string & = "global");
+        virtual void define_output(const std::string &, const std::string & = "results", const std::string & = "global", const solver_output & = solver_output(), const std::shared_ptr<output_writer> & = nullptr); //output parameters (format of the result files) and optional asynchronous writer
         virtual void output(const solver_output &, const int &, const int &, const int &, const int &, const double &, const std::string & = "global");
+        //Values of the columns written by output after block, cycle, step and inc (and their names if a vector is given). Returns the index of the first column of internal variables
+        virtual int output_columns(const solver_output &, const double &, const std::string &, arma::vec &, std::vector<std::string> * = nullptr) const;
     
     
         friend std::ostream& operator << (std::ostream&, const phase_characteristics&);
+    
+        //Statically typed access to the objects of the phase, without RTTI nor reference counting.
+        //The type must be the one created by construct for sv_type / shape_type (checked in debug builds only)
+        template<typename T> T* sv_global_as() const {
+            assert(dynamic_cast<T*>(sptr_sv_global.get()) != nullptr);
+            return static_cast<T*>(sptr_sv_global.get());
+        }
+        template<typename T> T* sv_local_as() const {
+            assert(dynamic_cast<T*>(sptr_sv_local.get()) != nullptr);
+            return static_cast<T*>(sptr_sv_local.get());
+        }
+        template<typename T> T* shape_as() const {
+            assert(dynamic_cast<T*>(sptr_shape.get()) != nullptr);
+            return static_cast<T*>(sptr_shape.get());
+        }
+        template<typename T> T* multi_as() const {
+            assert(dynamic_cast<T*>(sptr_multi.get()) != nullptr);
+            return static_cast<T*>(sptr_multi.get());
+        }
+};
+
+//======================================
+struct phase_view
+//======================================
+//Non-owning view of a phase: plain pointers on the objects shared by the phase_characteristics, so that traversing the phases does no allocation and no reference counting.
+//A view is valid as long as the phase it has been taken from.
+{
+    phase_characteristics *phase;
+    geometry *shape;
+    phase_multi *multi;
+    material_characteristics *matprops;
+    state_variables *sv_global;
+    state_variables *sv_local;
+    int level; //Depth of the phase in the hierarchy (0 for the phase the traversal starts from)
+    
+    phase_view(phase_characteristics &pc, const int &lvl = 0) : phase(&pc), shape(pc.sptr_shape.get()), multi(pc.sptr_multi.get()), matprops(pc.sptr_matprops.get()), sv_global(pc.sptr_sv_global.get()), sv_local(pc.sptr_sv_local.get()), level(lvl) {}
 };
 
+//Apply a visitor, callable with a phase_view, to a phase and recursively to all its sub-phases (depth first, a phase before its sub-phases)
+template<typename Visitor> void visit_phases(phase_characteristics &pc, Visitor &&visitor, const int &level = 0) {
+    visitor(phase_view(pc, level));
+    for(auto &r : pc.sub_phases) {
+        visit_phases(r, visitor, level+1);
+    }
+}
+
 } //namespace smart
@@ -23,6 +23,8 @@
 
 #include <iostream>
 #include <armadillo>
+#include "../Continuum_Mechanics/voigt.hpp"
+#include "../Maths/rotation_operators.hpp"
 
 namespace smart{
 
@@ -36,10 +38,10 @@ class state_variables
 
 	public :
 		
-		arma::vec Etot;
-		arma::vec DEtot;
-		arma::vec sigma;
-		arma::vec sigma_start;
+		vec6 Etot;
+		vec6 DEtot;
+		vec6 sigma;
+		vec6 sigma_start;
         double T;
         double DT;
     
@@ -64,6 +66,8 @@ class state_variables
     
         virtual state_variables& rotate_l2g(const state_variables&, const double&, const double&, const double&);
         virtual state_variables& rotate_g2l(const state_variables&, const double&, const double&, const double&);
+        virtual state_variables& rotate_l2g(const state_variables&, const rotation_operators&);   //Same as above, with precomputed rotation operators
+        virtual state_variables& rotate_g2l(const state_variables&, const rotation_operators&);
     
         friend std::ostream& operator << (std::ostream&, const state_variables&);
 };
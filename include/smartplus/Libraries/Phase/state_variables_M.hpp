@@ -37,11 +37,11 @@ class state_variables_M : public state_variables
 
 	public :
 		
-        arma::vec Wm;
-        arma::vec Wm_start;
+        arma::vec::fixed<4> Wm;
+        arma::vec::fixed<4> Wm_start;
     
-		arma::mat L;
-		arma::mat Lt;
+		mat66 L;
+		mat66 Lt;
 		
 		state_variables_M(); 	//default constructor
         state_variables_M(const arma::vec &, const arma::vec &, const arma::vec &, const arma::vec &, const double &, const double &, const arma::vec &, const arma::vec &, const int &, const arma::vec &, const arma::vec &, const arma::mat &, const arma::mat &); //Constructor with parameters
@@ -57,8 +57,10 @@ class state_variables_M : public state_variables
     
         using state_variables::rotate_l2g;
         virtual state_variables_M& rotate_l2g(const state_variables_M&, const double&, const double&, const double&);
+        virtual state_variables_M& rotate_l2g(const state_variables_M&, const rotation_operators&);
         using state_variables::rotate_g2l;
         virtual state_variables_M& rotate_g2l(const state_variables_M&, const double&, const double&, const double&);
+        virtual state_variables_M& rotate_g2l(const state_variables_M&, const rotation_operators&);
     
         friend std::ostream& operator << (std::ostream&, const state_variables_M&);
 };
@@ -37,13 +37,13 @@ namespace smart{
 
 	public :
     
-        arma::vec Wm;
-        arma::vec Wt;
-        arma::vec Wm_start;
-        arma::vec Wt_start;
+        arma::vec::fixed<4> Wm;
+        arma::vec::fixed<3> Wt;
+        arma::vec::fixed<4> Wm_start;
+        arma::vec::fixed<3> Wt_start;
 		
-        arma::mat dSdE;
-        arma::mat dSdEt;
+        mat66 dSdE;
+        mat66 dSdEt;
         arma::mat dSdT;
         double Q;
         double r;
@@ -65,9 +65,11 @@ namespace smart{
     
         using state_variables::rotate_l2g;
         virtual state_variables_T& rotate_l2g(const state_variables_T&, const double&, const double&, const double&);
+        virtual state_variables_T& rotate_l2g(const state_variables_T&, const rotation_operators&);
         using state_variables::rotate_g2l
     ;
         virtual state_variables_T& rotate_g2l(const state_variables_T&, const double&, const double&, const double&);
+        virtual state_variables_T& rotate_g2l(const state_variables_T&, const rotation_operators&);
     
         friend std::ostream& operator << (std::ostream&, const state_variables_T&);
 };
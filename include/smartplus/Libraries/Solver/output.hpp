@@ -22,6 +22,8 @@
 #pragma once
 
 #include <iostream>
+#include <string>
+#include <vector>
 #include <armadillo>
 
 namespace smart{
@@ -49,6 +51,8 @@ public :
     arma::Col<int> o_nfreq;
     arma::vec o_tfreq;
     
+    int o_format;   //format of the result files: 0 for ASCII, 1 for binary records (line "Format binary" at the end of output.dat)
+    
     solver_output(); 	//default constructor
     solver_output(const int&);	//Constructor with parameters
     solver_output(const solver_output &);	//Copy constructor
@@ -58,5 +62,42 @@ public :
     
     friend  std::ostream& operator << (std::ostream&, const solver_output&);
 };
+    
+//======================================
+class solver_results
+//======================================
+{
+private:
+    
+protected:
+    
+public :
+    
+    //Records of the global results kept in memory instead of written in the result files (see solver_context).
+    //A record holds the block, cycle, step and increment numbers followed by the values of the columns, in the order of the columns of the ASCII result files
+    int ncols;                  //number of columns of a record
+    std::vector<double> data;   //records, stored one after the other
+    
+    solver_results(); 	//default constructor
+    
+    void clear();
+    void push(const int &, const int &, const int &, const int &, const arma::vec &);
+    unsigned int size() const;  //number of records
+    arma::mat records() const;  //one row per record
+};
+    
+//Binary result files: a header ("SMARTOUT", version, number of columns and their names on 16 characters), then one record per output increment,
+//with the block, cycle, step and increment numbers (int32) followed by the values of the columns (double), in the order of the ASCII result files
+void write_binary_header(std::ostream &, const std::vector<std::string> &);
+void write_binary_record(std::ostream &, const int &, const int &, const int &, const int &, const arma::vec &);
+    
+//Same record in the layout of the ASCII result files (the last argument is the index of the first column of internal variables), without flush
+void write_ascii_record(std::ostream &, const int &, const int &, const int &, const int &, const arma::vec &, const int &);
+    
+//Read a binary result file: names of the columns, block/cycle/step/inc of each record (one row per record) and values of the columns
+void read_binary_output(const std::string &, std::vector<std::string> &, arma::Mat<int> &, arma::mat &);
+    
+//Convert a binary result file into the tab-separated ASCII one
+void binary2ascii(const std::string &, const std::string &);
 
 } //namespace smart
@@ -0,0 +1,75 @@
+/* This file is part of SMART+.
+ 
+ SMART+ is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ SMART+ is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with SMART+.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+
+///@file output_writer.hpp
+///@brief Asynchronous writer of the result files of the solver
+///@version 1.0
+
+#pragma once
+
+#include <iostream>
+#include <fstream>
+#include <memory>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <armadillo>
+
+namespace smart{
+
+//A record of a result file, see phase_characteristics::output_columns
+struct output_record {
+    std::shared_ptr<std::ofstream> sptr_out;   //the stream is kept open until the record is written
+    int format;         //0 for ASCII, 1 for binary (see solver_output::o_format)
+    int ids[4];         //block, cycle, step and increment numbers
+    arma::vec values;   //values of the columns
+    int first_statev;   //index of the first column of internal variables (ASCII layout)
+};
+    
+//======================================
+class output_writer
+//======================================
+{
+	private:
+    
+        //Bounded single-producer single-consumer ring: the solver pushes the records, the writer thread formats and writes them
+        std::vector<output_record> ring;
+        std::size_t mask;
+        std::atomic<std::size_t> head;     //next record to write (writer thread)
+        std::atomic<std::size_t> tail;     //next free slot (solver)
+        std::atomic<bool> stop;
+        std::thread worker;
+    
+        void run();
+
+	protected:
+
+	public :
+    
+		output_writer(const int &); //constructor with the capacity of the queue (rounded up to a power of 2), starts the writer thread
+        output_writer(const output_writer &) = delete;
+        output_writer& operator = (const output_writer &) = delete;
+        ~output_writer();   //all the records are written and the streams flushed before the destruction
+    
+        //Push a record, waits if the queue is full
+        void push(const std::shared_ptr<std::ofstream> &, const int &, const int &, const int &, const int &, const int &, const arma::vec &, const int &);
+    
+        //Write the remaining records, flush the streams and stop the writer thread. It is also called at the exit of the program for the writers alive
+        void close();
+};
+
+} //namespace smart
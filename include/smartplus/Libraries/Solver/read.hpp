@@ -24,6 +24,7 @@
 #include <string>
 #include "block.hpp"
 #include "output.hpp"
+#include "../Maths/lu_fixed.hpp"
 
 namespace smart{
 
@@ -35,6 +36,10 @@ void Lt_2_K(const arma::mat &, arma::mat &, const arma::Col<int> &, const double
 /// Function that fills the matrix Tdsde for mix strain/stress conditions
 void Lth_2_K(const arma::mat &, arma::mat &, arma::mat &, arma::mat &, arma::mat &, const arma::Col<int> &, const int &, const double &);
 
+/// Same functions, that fill the stack storage of the factorization used by the solver (see LU_fixed)
+void Lt_2_K(const arma::mat &, LU_fixed<6> &, const arma::Col<int> &, const double &);
+void Lth_2_K(const arma::mat &, const arma::mat &, const arma::mat &, const arma::mat &, LU_fixed<7> &, const arma::Col<int> &, const int &, const double &);
+
 /// Function that reads the material properties
 void read_matprops(std::string &, int &, arma::vec &, int &, double &, double &, double &, const std::string & = "data", const std::string & = "material.dat");
     
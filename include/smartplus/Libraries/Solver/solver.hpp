@@ -22,10 +22,21 @@
 #pragma once
 #include <armadillo>
 #include <string>
+#include <vector>
+#include "block.hpp"
+#include "output.hpp"
+#include "../Phase/phase_characteristics.hpp"
 
 namespace smart{
 
 //function that solves a
 void solver(const std::string &, const arma::vec &, const double &, const double &, const double &, const double &, const std::string& = "data", const std::string& = "results", const std::string& = "path.txt", const std::string& = "result_job.txt");
+    
+//Same solver with the loading path and the output parameters already read (see read_path and read_output). The steps of the blocks are regenerated during the run, so that the blocks can be used for several runs, one at a time
+void solver(const std::string &, const arma::vec &, const double &, const double &, const double &, const double &, std::vector<block> &, const double &, const solver_output &, const std::string& = "results", const std::string& = "result_job.txt");
+    
+//Same solver on a RVE whose material properties are set. The sub-phases already read for a multiphase UMAT are kept (see solver_context).
+//If a solver_results is given, the global records are stored in it and no result file is written
+void solver(phase_characteristics &, const double &, std::vector<block> &, const double &, const solver_output &, const std::string& = "results", const std::string& = "result_job.txt", solver_results * = nullptr);
 
 } //namespace smart
@@ -0,0 +1,81 @@
+/* This file is part of SMART+.
+ 
+ SMART+ is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ SMART+ is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with SMART+.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+
+///@file solver_context.hpp
+///@brief Loading path, outputs and microstructure read once, for several runs of the solver
+///@version 1.0
+
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <armadillo>
+#include "block.hpp"
+#include "output.hpp"
+#include "../Phase/phase_characteristics.hpp"
+
+namespace smart{
+
+//======================================
+class solver_context
+//======================================
+{
+	private:
+
+	protected:
+    
+        bool micro_read;        //true if the microstructure of rve_init has been read
+        arma::vec props_micro;  //props(0) to props(3) of the multiphase material used to read the microstructure
+    
+        void initialize();
+
+	public :
+    
+        std::string umat_name;
+        int umat_id;
+        int nstatev;
+        double psi_rve;
+        double theta_rve;
+        double phi_rve;
+    
+        std::vector<block> blocks;  //loading path
+        double T_init;              //initial temperature
+        solver_output so;           //output parameters
+    
+        phase_characteristics rve_init;    //RVE in its initial state, with the microstructure of a multiphase material
+        phase_characteristics rve;         //RVE at the end of the last run
+        solver_results results;            //global records of the last run
+    
+		solver_context(); 	//default constructor
+        solver_context(const std::string &, const int &, const double &, const double &, const double &, const std::string & = "data", const std::string & = "path.txt", const std::string & = "output.dat"); //Constructor that reads the loading path and the outputs
+        solver_context(const std::string &, const int &, const double &, const double &, const double &, const std::vector<block> &, const double &, const solver_output &);  //Constructor with the loading path and the outputs already read
+		solver_context(const solver_context &);	//Copy constructor (the steps of the blocks are shared)
+		~solver_context();
+    
+        //Run the solver from the initial state with the material properties props, and return the global records (see solver_results).
+        //The microstructure of a multiphase material is read at the first run, and again only if props(0) to props(3) change.
+        //The steps of the blocks are regenerated by each run, a context shall thus be used by one thread at a time
+        arma::mat run(const arma::vec &);
+    
+        //Restore the initial state: the RVE and the records are cleared and the microstructure is read again at the next run
+        void reset();
+				
+		virtual solver_context& operator = (const solver_context&);
+};
+
+} //namespace smart
@@ -22,6 +22,7 @@
 #pragma once
 
 #include <armadillo>
+#include "../parameter.hpp"
 #include "../Libraries/Phase/phase_characteristics.hpp"
 
 namespace smart{
@@ -32,6 +33,21 @@ namespace smart{
 ///@brief props[2] : Number of integration points in the 1 direction
 ///@brief props[3] : Number of integration points in the 2 direction
 
-void umat_multi(phase_characteristics &, const arma::mat &, const double &,const double &, const int &, const int &, const bool &, double &, const int &);
+//The last argument is the accelerator of the localization loop (see accelerator_micro in parameter.hpp)
+void umat_multi(phase_characteristics &, const arma::mat &, const double &,const double &, const int &, const int &, const bool &, double &, const int &, const int & = accelerator_micro);
+
+//Functions of a multiphase law, specialized for its homogenization scheme (see multiphase_schemes in schemes.hpp)
+struct multiphase_scheme
+{
+    void (*umat)(phase_characteristics &, const arma::mat &, const double &,const double &, const int &, const int &, const bool &, double &, const int &);   //umat_multi, the last argument is the accelerator
+    void (*L_elastic)(phase_characteristics &);    //get_L_elastic
+    void (*read)(phase_characteristics &);         //reads the microstructure of the phase
+};
+
+//Returns the scheme of the multiphase law id, NULL if the law is not a multiphase one
+const multiphase_scheme* find_scheme(const int &);
+    
+//Read the microstructure of a multiphase material and of its multiphase phases, so that it is not read again at the start of the UMAT
+void read_multi(phase_characteristics &, const int &);
 
 } //namespace smart
@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include <vector>
 #include <armadillo>
 #include "../Libraries/Phase/phase_characteristics.hpp"
 
@@ -39,10 +40,77 @@ void DE_Homogeneous_E(phase_characteristics &);
 void Lt_Mori_Tanaka(phase_characteristics &, const int &);
 void DE_Mori_Tanaka(phase_characteristics &, const int &);
     
+//Mori-Tanaka scheme for infinite cylindrical inclusions (fibres), with the closed-form Eshelby tensor of the cylinder
+void Lt_Mori_Tanaka_cylinder(phase_characteristics &, const int &);
+void DE_Mori_Tanaka_cylinder(phase_characteristics &, const int &);
+    
 void Lt_Self_Consistent(phase_characteristics &, const int &, const bool &, const int & = 1);
 void DE_Self_Consistent(phase_characteristics &, const int &, const bool &, const int & = 1);
 
+//Newton update of the strain increments of the phases for the Mori-Tanaka (101) and self-consistent (102) schemes, from the increments at which the phases have been evaluated
+void DE_Newton_localization(phase_characteristics &, const int &, const std::vector<arma::vec> &, const int &);
+
 void Lt_Periodic_Layer(phase_characteristics &);
 void dE_Periodic_Layer(phase_characteristics &, const int &);
+
+//Read the microstructure of a phase (file Nellipsoids[props[1]].dat, Ncylinders[props[1]].dat or Nlayers[props[1]].dat in data/)
+void read_scheme_ellipsoids(phase_characteristics &);
+void read_scheme_cylinders(phase_characteristics &);
+void read_scheme_layers(phase_characteristics &);
+    
+//======================================
+//Homogenization schemes
+//======================================
+//A scheme is a template parameter of umat_multi_scheme and get_L_elastic_scheme, so that its loops are inlined in the multiphase UMAT. It provides:
+// - id : the code of the multiphase law (see umat_registry)
+// - read(phase) : reads the microstructure of the phase
+// - localize(phase, start, nbiter) : strain increments of the sub-phases from the effective one, at the iteration nbiter of the localization loop
+// - tangent(phase, start, option_start) : strain concentration tensors of the sub-phases for the tangent modulus
+// - homogenize(phase) / homogenize_tangent(phase) : effective stress and/or tangent modulus from the sub-phases, common to all the schemes (scheme_base)
+//A new scheme only needs such a struct and an entry in multiphase_schemes: umat_multi, get_L_elastic, read_multi and select_umat_M find it from its id (see find_scheme in multiphase.hpp).
+
+struct scheme_base {
+    static void homogenize(phase_characteristics &);
+    static void homogenize_tangent(phase_characteristics &);
+};
+
+struct scheme_Homogeneous_E : scheme_base {
+    static const int id = 100;
+    static void read(phase_characteristics &phase) { read_scheme_ellipsoids(phase); }
+    static void localize(phase_characteristics &phase, const bool &, const int &) { DE_Homogeneous_E(phase); }
+    static void tangent(phase_characteristics &phase, const bool &, const int & = 0) { Lt_Homogeneous_E(phase); }
+};
+
+struct scheme_Mori_Tanaka : scheme_base {
+    static const int id = 101;
+    static void read(phase_characteristics &phase) { read_scheme_ellipsoids(phase); }
+    static void localize(phase_characteristics &phase, const bool &, const int &) { DE_Mori_Tanaka(phase, int(phase.sptr_matprops->props(4))); }
+    static void tangent(phase_characteristics &phase, const bool &, const int & = 0) { Lt_Mori_Tanaka(phase, int(phase.sptr_matprops->props(4))); }
+};
+
+struct scheme_Self_Consistent : scheme_base {
+    static const int id = 102;
+    static void read(phase_characteristics &phase) { read_scheme_ellipsoids(phase); }
+    static void localize(phase_characteristics &phase, const bool &start, const int &) { DE_Self_Consistent(phase, int(phase.sptr_matprops->props(4)), start, 0); }
+    static void tangent(phase_characteristics &phase, const bool &start, const int &option_start = 0) { Lt_Self_Consistent(phase, int(phase.sptr_matprops->props(4)), start, option_start); }
+};
+
+struct scheme_Mori_Tanaka_cylinder : scheme_base {
+    static const int id = 103;
+    static void read(phase_characteristics &phase) { read_scheme_cylinders(phase); }
+    static void localize(phase_characteristics &phase, const bool &, const int &) { DE_Mori_Tanaka_cylinder(phase, int(phase.sptr_matprops->props(4))); }
+    static void tangent(phase_characteristics &phase, const bool &, const int & = 0) { Lt_Mori_Tanaka_cylinder(phase, int(phase.sptr_matprops->props(4))); }
+};
+
+struct scheme_Periodic_Layer : scheme_base {
+    static const int id = 104;
+    static void read(phase_characteristics &phase) { read_scheme_layers(phase); }
+    static void localize(phase_characteristics &phase, const bool &, const int &nbiter) { dE_Periodic_Layer(phase, nbiter); }
+    static void tangent(phase_characteristics &phase, const bool &, const int & = 0) { Lt_Periodic_Layer(phase); }
+};
+
+//List of the multiphase schemes
+template<typename... schemes> struct scheme_list {};
+typedef scheme_list<scheme_Homogeneous_E, scheme_Mori_Tanaka, scheme_Self_Consistent, scheme_Mori_Tanaka_cylinder, scheme_Periodic_Layer> multiphase_schemes;
     
 } //namespace smart
@@ -26,5 +26,25 @@
 namespace smart{
 
 void get_L_elastic(phase_characteristics &);
+
+//Elastic tangent of a multiphase material for a homogenization scheme of schemes.hpp (see multiphase_schemes)
+template<typename scheme> void get_L_elastic_scheme(phase_characteristics &rve)
+{
+    //first we read the phases & we construct the tensors if necessary
+    scheme::read(rve);
+    
+    rve.global2local();
+    
+    for (auto &r : rve.sub_phases) {
+        get_L_elastic(r);
+    }
+    //The self-consistent estimate is converged on the effective modulus inside the scheme, starting from the Mori-Tanaka one
+    scheme::tangent(rve, true, 1);
+    
+    // Compute the effective tangent modulus
+    scheme::homogenize_tangent(rve);
+    
+    rve.local2global();
+}
     
 } //namespace smart
@@ -0,0 +1,52 @@
+/* This file is part of SMART+.
+ 
+ SMART+ is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ SMART+ is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with SMART+.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+
+///@file umat_registry.hpp
+///@brief Registry of the constitutive laws: resolution of the five-letter umat codes to an integer id and to the functions that implement them
+///@version 1.0
+
+#pragma once
+#include <string>
+#include <armadillo>
+
+namespace smart{
+
+//Id of the constitutive laws that are not registered
+#define umat_unknown 0
+//First id given to the constitutive laws registered by the user
+#define umat_user 1000
+
+///@brief Signature of the single-phase mechanical constitutive laws (see umat_elasticity_iso)
+typedef void (*umat_M_function)(const arma::vec &, const arma::vec &, arma::vec &, arma::mat &, const arma::mat &, const int &, const arma::vec &, const int &, arma::vec &, const double &, const double &, const double &, const double &, double &, double &, double &, double &, const int &, const int &, const bool &, double &);
+
+///@brief Signature of the single-phase thermomechanical constitutive laws (see umat_elasticity_iso_T)
+typedef void (*umat_T_function)(const arma::vec &, const arma::vec &, arma::vec &, double &, arma::mat &, arma::mat &, arma::mat &, arma::mat &, const arma::mat &, const int &, const arma::vec &, const int &, arma::vec &, const double &, const double &, const double &, const double &, double &, double &, double &, double &, double &, double &, double &, const int &, const int &, const bool &, double &);
+
+///@brief Returns the id of the constitutive law umat_name, umat_unknown if it is not registered
+int find_umat(const std::string &);
+
+///@brief Registers a new constitutive law under the name umat_name, with its mechanical and/or thermomechanical implementation (NULL if not available)
+///@brief Returns the id given to the law. Registration has to be done before the simulations are launched
+int register_umat(const std::string &, umat_M_function, umat_T_function = NULL);
+
+///@brief Returns the mechanical implementation of the law id, NULL if there is none (multiphase laws are handled by umat_multi)
+umat_M_function find_umat_M(const int &);
+
+///@brief Returns the thermomechanical implementation of the law id, NULL if there is none
+umat_T_function find_umat_T(const int &);
+
+} //namespace smart
@@ -57,6 +57,13 @@ void run_umat_T(phase_characteristics &, const arma::mat &, const double &, cons
 
 void run_umat_M(phase_characteristics &, const arma::mat &, const double &, const double &, const int &, const int &, bool &, double &);
 
+///@brief Batched evaluation of a mechanical constitutive law on npoints material points that share the same umat_name, props and material orientation
+///@param umat_name, props, nstatev, psi_mat, theta_mat, phi_mat : common material characteristics
+///@param Etot, DEtot, sigma (6 x npoints), Lt (6 x 6 x npoints), statev (nstatev x npoints), Wm (4 x npoints) : structure-of-arrays buffers, one column (or slice) per point
+///@param T, DT (npoints) : temperature and its increment ; DR (3 x 3 x npoints) : rotation increment of each point
+///@param nthreads : number of threads used to loop over the points (needs OpenMP)
+void run_umat_M_batch(const std::string &, const arma::vec &, const int &, const double &, const double &, const double &, const arma::mat &, const arma::mat &, arma::mat &, arma::cube &, arma::mat &, arma::mat &, const arma::vec &, const arma::vec &, const arma::cube &, const double &, const double &, const int &, const int &, bool &, double &, const int & = 1);
+
 void smart2abaqus(double *, double *, double *, const int &, const int &, const arma::vec &, const arma::mat &, const arma::vec &, double &, const double &);
     
 } //namespace smart
@@ -85,6 +85,11 @@ namespace smart {
 #define mul_tnew_dt_solver 2
 #endif
 
+//Jacobian of the mixed boundary conditions factorized at each iteration of the solver (0), or once per increment and reused (1, modified Newton method)
+#ifndef modified_newton_solver
+#define modified_newton_solver 0
+#endif
+
 
 #ifndef maxiter_micro
 #define maxiter_micro 100
@@ -94,4 +99,63 @@ namespace smart {
 #define precision_micro 1E-6
 #endif
 
+//Maximal number of passes and relative precision of the inner fixed point on the effective tangent of the self-consistent scheme
+#ifndef maxiter_self_consistent
+#define maxiter_self_consistent 20
+#endif
+
+#ifndef precision_self_consistent
+#define precision_self_consistent 1E-6
+#endif
+
+//Accelerator of the localization loop of the multiphase UMATs (0 : plain fixed-point iteration, 1 : Anderson mixing, 2 : Newton for the Mori-Tanaka and self-consistent schemes)
+#ifndef accelerator_micro
+#define accelerator_micro 0
+#endif
+
+//Number of previous iterates used by the Anderson mixing of the localization loop
+#ifndef anderson_depth_micro
+#define anderson_depth_micro 5
+#endif
+
+//Number of threads used to update the sub-phases of a multiphase UMAT (1 for a sequential update, needs OpenMP)
+#ifndef nthreads_micro
+#define nthreads_micro 1
+#endif
+
+//Number of individuals of a generation simulated at the same time during an identification (1 for a sequential run, needs OpenMP)
+#ifndef nthreads_identification
+#define nthreads_identification 1
+#endif
+
+//Parameters and constants of an identification bound in memory to the material properties and the loading paths when possible (1), or always substituted in the files (0)
+#ifndef key_binding_identification
+#define key_binding_identification 1
+#endif
+
+//Results of the simulations of an identification kept in memory when the keys are bound (1), or written in result files and read back (0). The identified simulation is always written
+#ifndef memory_results_identification
+#define memory_results_identification 1
+#endif
+
+//Number of output records queued for the writer thread of the solver (0 for synchronous writes of the result files)
+#ifndef output_queue_size
+#define output_queue_size 1024
+#endif
+
+//Number of numerical Eshelby/Hill tensors kept in memory (0 disables the cache)
+#ifndef eshelby_cache_size
+#define eshelby_cache_size 64
+#endif
+
+//Relative tolerance on the matrix tangent and the semi-axes to reuse a cached tensor (0 for an exact match)
+#ifndef eshelby_cache_tol
+#define eshelby_cache_tol 0.
+#endif
+
+//Relative distance of the matrix tangent to its isotropic projection below which the closed-form Eshelby tensors are used
+#ifndef eshelby_iso_tol
+#define eshelby_iso_tol 1.E-8
+#endif
+
 } //end of namespace smart
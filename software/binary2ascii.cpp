@@ -0,0 +1,42 @@
+/* This file is part of SMART+.
+ 
+ SMART+ is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ SMART+ is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with SMART+.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+///@file binary2ascii.cpp
+///@brief binary2ascii: convert a binary result file of the solver (Format binary in output.dat) into the tab-separated ASCII one
+///@version 1.0
+
+#include <iostream>
+#include <string>
+#include <armadillo>
+#include <smartplus/Libraries/Solver/output.hpp>
+
+using namespace std;
+using namespace arma;
+using namespace smart;
+
+int main(int argc, char *argv[]) {
+
+    if (argc < 3) {
+        cout << "usage: binary2ascii binary_file ascii_file\n";
+        return 1;
+    }
+    
+    string binfile = argv[1];
+    string asciifile = argv[2];
+    binary2ascii(binfile, asciifile);
+    
+	return 0;
+}
@@ -109,7 +109,7 @@ vec Ir05(){
 //The two first arguments are a couple of Lamé coefficients. The third argument specify which couple has been provided and the order of coefficients.
 //Exhaustive list of possible third argument :
 // ‘Enu’,’nuE,’Kmu’,’muK’, ‘KG’, ‘GK’, ‘lambdamu’, ‘mulambda’, ‘lambdaG’, ‘Glambda’.
-mat L_iso(const double &C1, const double &C2, const std::string &conv) {
+void L_iso(mat &L, const double &C1, const double &C2, const std::string &conv) {
 	
 	double K = 0.;
 	double mu = 0.;	
@@ -154,14 +154,29 @@ mat L_iso(const double &C1, const double &C2, const std::string &conv) {
 		cout << "ERROR : Please use a valid couple of elastic constants";
 	}
 	
-	return 3.*K*Ivol() + 2.*mu*Idev();
+	//Same as 3.*K*Ivol() + 2.*mu*Idev(), written term by term to avoid the temporaries
+	L.zeros(6,6);
+	for (int i=0; i<3; i++) {
+		for (int j=0; j<3; j++) {
+			L(i,j) = 3.*K*(1./3.) + 2.*mu*(((i==j) ? 1. : 0.) - (1./3.));
+		}
+	}
+	for (int i=3; i<6; i++)
+		L(i,i) = 2.*mu*0.5;
+}
+
+mat L_iso(const double &C1, const double &C2, const std::string &conv) {
+	
+	mat L(6,6);
+	L_iso(L, C1, C2, conv);
+	return L;
 }
 
 //Provides the elastic compliance tensor for an isotropic material.
 //The two first arguments are a couple of Lamé coefficients. The third argument specify which couple has been provided and the order of coefficients.
 //Exhaustive list of possible third argument :
 //‘Enu’,’nuE,’Kmu’,’muK’, ‘KG’, ‘GK’, ‘lambdamu’, ‘mulambda’, ‘lambdaG’, ‘Glambda’.
-mat M_iso(const double &C1, const double &C2, const string &conv) {
+void M_iso(mat &M, const double &C1, const double &C2, const string &conv) {
 	
 	double K = 0.;
 	double mu = 0.;	
@@ -207,7 +222,22 @@ mat M_iso(const double &C1, const double &C2, const string &conv) {
         exit(0);
 	}
 	
-	return 1/(3.*K)*Ivol() + 1/(2.*mu)*Idev2();
+	//Same as 1/(3.*K)*Ivol() + 1/(2.*mu)*Idev2(), written term by term to avoid the temporaries
+	M.zeros(6,6);
+	for (int i=0; i<3; i++) {
+		for (int j=0; j<3; j++) {
+			M(i,j) = 1/(3.*K)*(1./3.) + 1/(2.*mu)*(((i==j) ? 1. : 0.) - (1./3.));
+		}
+	}
+	for (int i=3; i<6; i++)
+		M(i,i) = 1/(2.*mu)*2.;
+}
+
+mat M_iso(const double &C1, const double &C2, const string &conv) {
+	
+	mat M(6,6);
+	M_iso(M, C1, C2, conv);
+	return M;
 }
 
 //Returns the elastic stiffness tensor for a cubic material.
@@ -307,8 +337,8 @@ mat M_cubic(const double &C1, const double &C2, const double &C4, const string &
 
 //Returns the elastic stiffness tensor for an orthotropic material.
 //Arguments are the stiffness coefficients Cii or E and nu's
-mat L_ortho(const double &C11, const double &C12, const double &C13, const double &C22, const double &C23, const double &C33, const double &C44, const double &C55, const double &C66, const string &conv){
-	mat L = zeros(6,6);
+void L_ortho(mat &L, const double &C11, const double &C12, const double &C13, const double &C22, const double &C23, const double &C33, const double &C44, const double &C55, const double &C66, const string &conv){
+	L.zeros(6,6);
 	
 	if (conv == "Cii") {
 	    L(0,0) = C11;
@@ -359,7 +389,12 @@ mat L_ortho(const double &C11, const double &C12, const double &C13, const doubl
         cout << "ERROR : Please use a valid couple of elastic constants";
         exit(0);
     }
+}
+
+mat L_ortho(const double &C11, const double &C12, const double &C13, const double &C22, const double &C23, const double &C33, const double &C44, const double &C55, const double &C66, const string &conv){
 	
+	mat L(6,6);
+	L_ortho(L, C11, C12, C13, C22, C23, C33, C44, C55, C66, conv);
 	return L;
 }
 
@@ -421,9 +456,9 @@ mat M_ortho(const double &C11, const double &C12, const double &C13, const doubl
 
 //Returns the elastic stiffness tensor for an isotropic transverse material.
 //Arguments are longitudinal Young modulus EL, transverse young modulus, Poisson’s ratio for loading along the longitudinal axis nuTL, Poisson’s ratio for loading along the transverse axis nuTT, shear modulus GLT and the axis of symmetry.
-mat L_isotrans(const double &EL, const double &ET, const double &nuTL, const double &nuTT, const double &GLT, const int &axis){
+void L_isotrans(mat &L, const double &EL, const double &ET, const double &nuTL, const double &nuTT, const double &GLT, const int &axis){
 	
-    mat L = zeros(6,6);
+    L.zeros(6,6);
     double delta = (1.+nuTT)*(2*EL*nuTL*nuTL+ET*(nuTT-1.))/ET;
 
 	switch(axis) {
@@ -478,8 +513,12 @@ mat L_isotrans(const double &EL, const double &ET, const double &nuTL, const dou
         }
             
 	}
+}
 
-    
+mat L_isotrans(const double &EL, const double &ET, const double &nuTL, const double &nuTT, const double &GLT, const int &axis){
+	
+	mat L(6,6);
+	L_isotrans(L, EL, ET, nuTL, nuTT, GLT, axis);
 	return L;
 }
 
@@ -60,32 +60,40 @@ vec dev(const vec &v) {
 double Mises_stress(const vec &v) {
 	assert(v.size()==6);
 
-	vec vdev = dev(v);
-	vec vdev2 = vdev;
+	//Same as sqrt(3./2.*sum(dev(v)%vdev2)), without the temporary vectors
+	double sph = (1./3.)*(v(0) + v(1) + v(2));
+	double J = 0.;
+	for (int i=0; i<3; i++)
+		J += (v(i) - sph)*(v(i) - sph);
 	for (int i=3; i<6; i++)
-		vdev2(i) = 2.*vdev2(i);	
+		J += v(i)*(2.*v(i));
 
-	return sqrt(3./2.*sum(vdev%vdev2));
+	return sqrt(3./2.*J);
 }
 
 //This function determines the strain flow (direction) from a stress tensor, according to the Voigt convention for strains
-vec eta_stress(const vec &v) {
+void eta_stress(const vec &v, vec &eta) {
 	assert(v.size()==6);
+	assert(eta.size()==6);
 	
-	vec vdev = dev(v);
-	vec vdev2 = vdev;	
-	for (int i=3; i<6; i++)
-		vdev2(i) = 2.*vdev2(i);	
-		
-	double n = sqrt(3./2.*sum(vdev%vdev2));
-
-	if (n > 0.) {		
-		return (3./2.)*vdev2*(1./n);
+	double n = Mises_stress(v);
+	if (n > 0.) {
+		double sph = (1./3.)*(v(0) + v(1) + v(2));
+		for (int i=0; i<3; i++)
+			eta(i) = (3./2.)*(v(i) - sph)*(1./n);
+		for (int i=3; i<6; i++)
+			eta(i) = (3./2.)*(2.*v(i))*(1./n);
 	}
 	else {
-		return zeros(6);
+		eta.zeros();
 	}
+}
 
+vec eta_stress(const vec &v) {
+	
+	vec eta(6);
+	eta_stress(v, eta);
+	return eta;
 }
 
 //This function determines the Mises equivalent of a strain tensor, according to the Voigt convention for strains 
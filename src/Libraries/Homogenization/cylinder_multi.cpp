@@ -29,6 +29,8 @@
 #include <smartplus/Libraries/Phase/phase_characteristics.hpp>
 #include <smartplus/Libraries/Phase/state_variables_M.hpp>
 #include <smartplus/Libraries/Geometry/cylinder.hpp>
+#include <smartplus/Libraries/Continuum_Mechanics/recovery_props.hpp>
+#include <smartplus/Libraries/Homogenization/eshelby.hpp>
 #include <smartplus/Libraries/Homogenization/cylinder_multi.hpp>
 
 using namespace std;
@@ -46,7 +48,7 @@ namespace smart{
 */
     
 //-------------------------------------------------------------
-cylinder_multi::cylinder_multi() : phase_multi(), T_loc(6,6), T(6,6), A_loc(6,6), B_loc(6,6)
+cylinder_multi::cylinder_multi() : phase_multi(), S_loc(6,6), T_loc(6,6), T(6,6), A_loc(6,6), B_loc(6,6)
 //-------------------------------------------------------------
 {
     //This calls only the constructor of the two matrix A & B
@@ -58,7 +60,7 @@ cylinder_multi::cylinder_multi() : phase_multi(), T_loc(6,6), T(6,6), A_loc(6,6)
 */
 
 //-------------------------------------------------------------
-cylinder_multi::cylinder_multi(const mat &mA, const mat &mA_start, const mat &mB, const mat &mB_start, const mat &mA_loc, const mat &mB_loc, const mat &mT_loc, const mat &mT) : phase_multi(mA, mA_start, mB, mB_start), T_loc(6,6), T(6,6), A_loc(6,6), B_loc(6,6)
+cylinder_multi::cylinder_multi(const mat &mA, const mat &mA_start, const mat &mB, const mat &mB_start, const mat &mA_loc, const mat &mB_loc, const mat &mT_loc, const mat &mT) : phase_multi(mA, mA_start, mB, mB_start), S_loc(6,6), T_loc(6,6), T(6,6), A_loc(6,6), B_loc(6,6)
 //-------------------------------------------------------------
 {
     T_loc = mT_loc;
@@ -74,14 +76,17 @@ cylinder_multi::cylinder_multi(const mat &mA, const mat &mA_start, const mat &mB
 */
     
 //------------------------------------------------------
-cylinder_multi::cylinder_multi(const cylinder_multi& pc) : phase_multi(pc), T_loc(6,6), T(6,6), A_loc(6,6), B_loc(6,6)
+cylinder_multi::cylinder_multi(const cylinder_multi& pc) : phase_multi(pc), S_loc(6,6), T_loc(6,6), T(6,6), A_loc(6,6), B_loc(6,6)
 //------------------------------------------------------
 {
+    S_loc = pc.S_loc;
     T_loc = pc.T_loc;
     T = pc.T;
     
     A_loc = pc.A_loc;
     B_loc = pc.B_loc;
+    
+    rot_geom = pc.rot_geom;
 }
 
 /*!
@@ -94,6 +99,32 @@ cylinder_multi::cylinder_multi(const cylinder_multi& pc) : phase_multi(pc), T_lo
 cylinder_multi::~cylinder_multi() {}
 //-------------------------------------
 
+//-------------------------------------
+void cylinder_multi::fillS_loc(const mat& Lt_m, const cylinder &cyl)
+//-------------------------------------
+{
+    rot_geom.update(cyl.psi_geom, cyl.theta_geom, cyl.phi_geom);
+    mat Ltm_local_geom = rot_geom.g2l_L(Lt_m);
+    
+    //For a non-isotropic tangent of the matrix the Poisson ratio is the one of its isotropic part
+    vec props_iso = L_iso_props(Ltm_local_geom);
+    S_loc = Eshelby_cylinder(props_iso(1));
+}
+    
+//-------------------------------------
+void cylinder_multi::fillT(const mat& Lt_m, const mat& Lt, const cylinder &cyl)
+//This method correspond to the classical Eshelby method
+//-------------------------------------
+{
+    fillS_loc(Lt_m, cyl);
+    mat Lt_m_local_geom = rot_geom.g2l_L(Lt_m);
+    mat Lt_local_geom = rot_geom.g2l_L(Lt);
+    
+    T_loc = inv(eye(6,6) + S_loc*inv(Lt_m_local_geom)*(Lt_local_geom - Lt_m_local_geom));
+    
+    T = rot_geom.l2g_A(T_loc);
+}
+    
 /*!
   \brief Standard operator = for phase_multi
 */
@@ -108,13 +139,18 @@ cylinder_multi& cylinder_multi::operator = (const cylinder_multi& pc)
 
     A_start = pc.A_start;
     B_start = pc.B_start;
+    nbiter = pc.nbiter;
+    nbiter_self_consistent = pc.nbiter_self_consistent;
     
     A_loc = pc.A_loc;
     B_loc = pc.B_loc;
     
+    S_loc = pc.S_loc;
     T_loc = pc.T_loc;
     T = pc.T;
     
+    rot_geom = pc.rot_geom;
+    
 	return *this;
 }
     
@@ -132,6 +168,8 @@ ostream& operator << (ostream& s, const cylinder_multi& pc)
     s << "Display stress concentration tensor (local coordinates):\n";
     s << pc.B_loc;
 
+    s << "Display Eshelby tensor (local coordinates):\n";
+    s << pc.S_loc;
     s << "Display Interaction concentration tensor (local coordinates):\n";
     s << pc.T_loc;
     s << "Display Interaction concentration tensor (global coordinates):\n";
@@ -34,15 +34,6 @@ using namespace arma;
 
 namespace smart{
 
-//Definition of the static variables
-int ellipsoid_multi::mp;
-int ellipsoid_multi::np;
-vec ellipsoid_multi::x;
-vec ellipsoid_multi::wx;
-vec ellipsoid_multi::y;
-vec ellipsoid_multi::wy;
-    
-    
 //=====Private methods for ellipsoid_multi===================================
 
 //=====Public methods for ellipsoid_multi====================================
@@ -86,6 +77,8 @@ ellipsoid_multi::ellipsoid_multi(const ellipsoid_multi& pc) : phase_multi(pc), S
     P_loc = pc.P_loc;
     T_loc = pc.T_loc;
     T = pc.T;
+    rot_geom = pc.rot_geom;
+    gauss = pc.gauss;
 }
 
 /*!
@@ -106,16 +99,20 @@ ellipsoid_multi::~ellipsoid_multi() {}
 void ellipsoid_multi::fillS_loc(const mat& Lt_m, const ellipsoid &ell)
 //-------------------------------------
 {
-    mat Ltm_local_geom = rotate_g2l_L(Lt_m, ell.psi_geom, ell.theta_geom, ell.phi_geom);
-    S_loc = Eshelby(Ltm_local_geom, ell.a1, ell.a2, ell.a3, x, wx, y, wy, mp, np);
+    assert(gauss);
+    rot_geom.update(ell.psi_geom, ell.theta_geom, ell.phi_geom);
+    mat Ltm_local_geom = rot_geom.g2l_L(Lt_m);
+    S_loc = Eshelby_cached(Ltm_local_geom, ell.a1, ell.a2, ell.a3, *gauss);
 }
     
 //-------------------------------------
 void ellipsoid_multi::fillP_loc(const mat& Lt_m, const ellipsoid &ell)
 //-------------------------------------
 {
-    mat Ltm_local_geom = rotate_g2l_L(Lt_m, ell.psi_geom, ell.theta_geom, ell.phi_geom);
-    P_loc = T_II(Ltm_local_geom, ell.a1, ell.a2, ell.a3, x, wx, y, wy, mp, np);
+    assert(gauss);
+    rot_geom.update(ell.psi_geom, ell.theta_geom, ell.phi_geom);
+    mat Ltm_local_geom = rot_geom.g2l_L(Lt_m);
+    P_loc = T_II_cached(Ltm_local_geom, ell.a1, ell.a2, ell.a3, *gauss);
 }
     
 
@@ -124,13 +121,15 @@ void ellipsoid_multi::fillT(const mat& Lt_m, const mat& Lt, const ellipsoid &ell
 //This method correspond to the classical Eshelby method
 //-------------------------------------
 {
-    mat Lt_m_local_geom = rotate_g2l_L(Lt_m, ell.psi_geom, ell.theta_geom, ell.phi_geom);
-    S_loc = Eshelby(Lt_m_local_geom, ell.a1, ell.a2, ell.a3, x, wx, y, wy, mp, np);
-    mat Lt_local_geom = rotate_g2l_L(Lt, ell.psi_geom, ell.theta_geom, ell.phi_geom);
+    assert(gauss);
+    rot_geom.update(ell.psi_geom, ell.theta_geom, ell.phi_geom);
+    mat Lt_m_local_geom = rot_geom.g2l_L(Lt_m);
+    S_loc = Eshelby_cached(Lt_m_local_geom, ell.a1, ell.a2, ell.a3, *gauss);
+    mat Lt_local_geom = rot_geom.g2l_L(Lt);
     
     T_loc = inv(eye(6,6) + S_loc*inv(Lt_m_local_geom)*(Lt_local_geom - Lt_m_local_geom));
     
-    T = rotate_l2g_A(T_loc, ell.psi_geom, ell.theta_geom, ell.phi_geom);
+    T = rot_geom.l2g_A(T_loc);
 }
 
 //-------------------------------------
@@ -138,9 +137,11 @@ void ellipsoid_multi::fillT_m(const mat& Lt_m, const mat& Lt, const ellipsoid &e
 //This method corresponf to the Ponte-astenada and Willis method
 //-------------------------------------
 {
-    mat Lt_m_local_geom = rotate_g2l_L(Lt_m, ell.psi_geom, ell.theta_geom, ell.phi_geom);    
-    P_loc = T_II(Lt_m_local_geom, ell.a1, ell.a2, ell.a3, x, wx, y, wy, mp, np);
-    mat P = rotate_l2g_M(P_loc, ell.psi_geom, ell.theta_geom, ell.phi_geom);
+    assert(gauss);
+    rot_geom.update(ell.psi_geom, ell.theta_geom, ell.phi_geom);
+    mat Lt_m_local_geom = rot_geom.g2l_L(Lt_m);
+    P_loc = T_II_cached(Lt_m_local_geom, ell.a1, ell.a2, ell.a3, *gauss);
+    mat P = rot_geom.l2g_M(P_loc);
     
     T = inv(inv(Lt - Lt_m) + P);
 }
@@ -154,11 +155,15 @@ ellipsoid_multi& ellipsoid_multi::operator = (const ellipsoid_multi& pc)
 
     A_start = pc.A_start;
     B_start = pc.B_start;
+    nbiter = pc.nbiter;
+    nbiter_self_consistent = pc.nbiter_self_consistent;
     
     S_loc = pc.S_loc;
     P_loc = pc.P_loc;
     T_loc = pc.T_loc;
     T = pc.T;
+    rot_geom = pc.rot_geom;
+    gauss = pc.gauss;
     
 	return *this;
 }
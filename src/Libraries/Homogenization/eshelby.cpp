@@ -21,14 +21,47 @@
 ///@version 1.0
 
 #include <math.h>
+#include <string>
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <functional>
 #include <armadillo>
 #include <smartplus/parameter.hpp>
+#include <smartplus/Libraries/Continuum_Mechanics/voigt.hpp>
+#include <smartplus/Libraries/Continuum_Mechanics/constitutive.hpp>
+#include <smartplus/Libraries/Continuum_Mechanics/recovery_props.hpp>
 #include <smartplus/Libraries/Homogenization/eshelby.hpp>
 
 using namespace std;
 using namespace arma;
 
 namespace smart{
+
+shared_ptr<const Gauss_points> get_Gauss_points(const int &mp, const int &np) {
+    
+    static std::map<std::pair<int,int>, shared_ptr<const Gauss_points> > tables;
+    static std::mutex tables_mutex;
+    
+    std::lock_guard<std::mutex> lock(tables_mutex);
+    auto it = tables.find(std::make_pair(mp, np));
+    if (it != tables.end())
+        return it->second;
+    
+    auto table = make_shared<Gauss_points>();
+    table->mp = mp;
+    table->np = np;
+    table->x = zeros(mp);
+    table->wx = zeros(mp);
+    table->y = zeros(np);
+    table->wy = zeros(np);
+    points(table->x, table->wx, table->y, table->wy, mp, np);
+    
+    tables[std::make_pair(mp, np)] = table;
+    return table;
+}
     
 //Eshelby tensor for a sphere
 mat Eshelby_sphere(const double &nu) {
@@ -116,6 +149,34 @@ mat Eshelby_oblate(const double &nu, const double &ar) {
 	return S;
 }
 
+bool Eshelby_closed_form(const mat &Lt, const double &a1, const double &a2, const double &a3, mat &S) {
+    
+    //The closed-form expressions are written for a spheroid of axis 1
+    if (fabs(a2-a3) > iota*fabs(a2))
+        return false;
+    
+    //Close to a sphere, the expressions of the prolate and oblate shapes loose their accuracy: the sphere is then treated exactly and the rest numerically
+    double ar = a1/a2;
+    bool sphere = (fabs(ar-1.) < iota);
+    if ((!sphere)&&(fabs(ar-1.) < 1.E-3))
+        return false;
+    
+    //Relative distance of the tangent to its isotropic projection (a degenerate projection gives NaN and is rejected)
+    vec props = L_iso_props(Lt);
+    double dist = norm(Lt - L_iso(props(0), props(1), "Enu"), "fro");
+    if (!(dist <= eshelby_iso_tol*norm(Lt, "fro")))
+        return false;
+    
+    double nu = props(1);
+    if (sphere)
+        S = Eshelby_sphere(nu);
+    else if (ar > 1.)
+        S = Eshelby_prolate(nu, ar);
+    else
+        S = Eshelby_oblate(nu, ar);
+    return true;
+}
+
 //This methods is using the Voigt notations for the tensors.
 void calG(const double &pt, const double &a1, const double &a2, const double &a3, const double &x3, const Mat<int> &Id, const mat &Lt, mat &G)
 {
@@ -171,42 +232,83 @@ void calG(const double &pt, const double &a1, const double &a2, const double &a3
 
 }
 
-void Gauss(Mat<int> &Id, const mat &Lt, mat &G, const double &a1, const double &a2, const double &a3, const vec &x, const vec &wx, const vec &y, const vec &wy, const int &mp, const int &np) // To check
+//Voigt index of the pair (i,j) of a symmetric second order tensor
+static const int Id_Voigt[3][3] = { {0,3,4}, {3,1,5}, {4,5,2} };
+//Pairs (i,j), i<=j, in the order of the Voigt notation
+static const int Id_pair_i[6] = {0,1,2,0,0,1};
+static const int Id_pair_j[6] = {0,1,2,1,2,2};
+    
+void Gauss(const mat &Lt, mat &G, const double &a1, const double &a2, const double &a3, const vec &x, const vec &wx, const vec &y, const vec &wy, const int &mp, const int &np)
 {
-	double x3 = 0.;
-	double pt=0.;
-	mat H = zeros(6,6);
-	mat rg = zeros(6,6);
-    	
-	for (int l=0; l<mp; l++) {
-		x3 = x(l);
-		
-		for (int i=0; i<np; i++) {
-			pt = y(i);
-			    
-			calG(pt, a1, a2, a3, x3, Id, Lt, H);
-    
-			for (int k=0; k<6; k++) {
-				for (int j=0; j<6; j++) {
-					rg(k,j) = H(k,j)*wy(i)+rg(k,j);
-				}
-			}
-			
-			for (int im=0; im<6; im++) {
-				for (int jm=0; jm <6; jm++) {
-					G(im,jm) = G(im,jm) + wx(l)*rg(im,jm);
-					rg(im,jm) = 0.;
-				}
-			}
-		}
-	}
+    //Coefficients of the acoustic tensor K(i,k) = Lt(ij,kl)*X(j)*X(l), gathered on the symmetric products X(j)*X(l).
+    //Both K and X(j)*X(l) are stored in the Voigt order
+    double C[6][6];
+    for (int a=0; a<6; a++) {
+        int i = Id_pair_i[a];
+        int k = Id_pair_j[a];
+        for (int b=0; b<6; b++) {
+            int j = Id_pair_i[b];
+            int l = Id_pair_j[b];
+            C[a][b] = Lt(Id_Voigt[i][j],Id_Voigt[k][l]);
+            if (j != l)
+                C[a][b] += Lt(Id_Voigt[i][l],Id_Voigt[k][j]);
+        }
+    }
+    
+    vec cos_y = cos(y);
+    vec sin_y = sin(y);
+    
+    //Each x3 is evaluated for all the np points at once: XX stores X(k)*X(l) and Nw the inverse of the acoustic tensor weighted by wy, one row per point
+    mat XX(np,6);
+    mat Nw(np,6);
+    double K[6];
+    
+    for (int l=0; l<mp; l++) {
+        double x3 = x(l);
+        double x1 = sqrt(1.-x3*x3);
+        double X2 = x3*(1./a3);
+        
+        for (int i=0; i<np; i++) {
+            double X0 = x1*cos_y(i)*(1./a1);
+            double X1 = x1*sin_y(i)*(1./a2);
+            XX(i,0) = X0*X0;
+            XX(i,1) = X1*X1;
+            XX(i,2) = X2*X2;
+            XX(i,3) = X0*X1;
+            XX(i,4) = X0*X2;
+            XX(i,5) = X1*X2;
+        }
+        
+        for (int i=0; i<np; i++) {
+            for (int a=0; a<6; a++) {
+                K[a] = C[a][0]*XX(i,0) + C[a][1]*XX(i,1) + C[a][2]*XX(i,2) + C[a][3]*XX(i,3) + C[a][4]*XX(i,4) + C[a][5]*XX(i,5);
+            }
+            
+            //Inverse of the (symmetric) acoustic tensor from its adjugate
+            double n00 = K[1]*K[2] - K[5]*K[5];
+            double n01 = -1.*(K[3]*K[2] - K[5]*K[4]);
+            double n02 = K[3]*K[5] - K[1]*K[4];
+            double n11 = K[0]*K[2] - K[4]*K[4];
+            double n12 = -1.*(K[0]*K[5] - K[3]*K[4]);
+            double n22 = K[0]*K[1] - K[3]*K[3];
+            double w = wy(i)/(n00*K[0] + n01*K[3] + n02*K[4]);
+            
+            Nw(i,0) = n00*w;
+            Nw(i,1) = n11*w;
+            Nw(i,2) = n22*w;
+            Nw(i,3) = n01*w;
+            Nw(i,4) = n02*w;
+            Nw(i,5) = n12*w;
+        }
+        
+        //G(ij,kl) += wx*sum(wy*N(i,j)*X(k)*X(l)) over the points of this x3
+        G += wx(l)*(trans(Nw)*XX);
+    }
 }
     
 mat Eshelby(const mat &Lt, const double &a1, const double &a2, const double &a3, const vec &x, const vec &wx, const vec &y, const vec &wy, const int &mp, const int &np)
 {
     mat G = zeros(6,6);
-	Mat<int> Id(6,6);
-    Id.zeros();
 
     mat S = zeros(6,6);
 	int ij=0;
@@ -217,31 +319,21 @@ mat Eshelby(const mat &Lt, const double &a1, const double &a2, const double &a3,
 	int jp=0;
 	int iq=0;
 		
-    Id(0,0) = 0;
-    Id(0,1) = 3;
-    Id(0,2) = 4;
-    Id(1,0) = 3;
-    Id(1,1) = 1;
-    Id(1,2) = 5;
-    Id(2,0) = 4;
-    Id(2,1) = 5;
-    Id(2,2) = 2;
-    
-	Gauss(Id, Lt, G, a1, a2, a3, x, wx, y, wy, mp, np);
+	Gauss(Lt, G, a1, a2, a3, x, wx, y, wy, mp, np);
 	    
 	for (int i=0; i<3; i++) {
 		for (int j=i; j<3; j++) {
-			ij = Id(i,j);
+			ij = Id_Voigt[i][j];
 			for (int m=0; m<3; m++) {
 				for (int n=m; n<3; n++) {
-					mn = Id(m,n);
+					mn = Id_Voigt[m][n];
 					for (int p=0; p<3; p++) {
 						for (int q=0; q<3; q++) {
-							pq = Id(p,q);
-							ip = Id(i,p);
-							jq = Id(j,q);
-							jp = Id(j,p);
-							iq = Id(i,q);
+							pq = Id_Voigt[p][q];
+							ip = Id_Voigt[i][p];
+							jq = Id_Voigt[j][q];
+							jp = Id_Voigt[j][p];
+							iq = Id_Voigt[i][q];
 							S(ij,mn) = S(ij,mn)+Lt(pq,mn)*(G(ip,jq)+G(jp,iq));
 						}
 					}
@@ -266,12 +358,12 @@ mat Eshelby(const mat &Lt, const double &a1, const double &a2, const double &a3,
 
 mat Eshelby(const mat &Lt, const double &a1, const double &a2, const double &a3, const int &mp, const int &np) {
     
-    vec x(mp);
-    vec wx(mp);
-    vec y(np);
-    vec wy(np);
-    points(x, wx, y, wy, mp, np);
-    return Eshelby(Lt, a1, a2, a3, x, wx, y, wy, mp, np);
+    return Eshelby(Lt, a1, a2, a3, *get_Gauss_points(mp, np));
+}
+
+mat Eshelby(const mat &Lt, const double &a1, const double &a2, const double &a3, const Gauss_points &gp) {
+    
+    return Eshelby(Lt, a1, a2, a3, gp.x, gp.wx, gp.y, gp.wy, gp.mp, gp.np);
 }
     
 /*mat T_II_sphere(const double &nu, const double &mu) {
@@ -299,8 +391,6 @@ mat Eshelby(const mat &Lt, const double &a1, const double &a2, const double &a3,
 mat T_II(const mat &Lt, const double &a1, const double &a2, const double &a3, const vec &x, const vec &wx, const vec &y, const vec &wy, const int &mp, const int &np)
 {   
 	mat G = zeros(6,6);
-	Mat<int> Id(6,6);
-    Id.zeros();
     
     mat T_II = zeros(6,6);
     mat I = eye(6,6);
@@ -313,31 +403,21 @@ mat T_II(const mat &Lt, const double &a1, const double &a2, const double &a3, co
 	int jp=0;
 	int iq=0;
     
-    Id(0,0) = 0;
-    Id(0,1) = 3;
-    Id(0,2) = 4;
-    Id(1,0) = 3;
-    Id(1,1) = 1;
-    Id(1,2) = 5;
-    Id(2,0) = 4;
-    Id(2,1) = 5;
-    Id(2,2) = 2;
-        
-	Gauss(Id, Lt, G, a1, a2, a3, x, wx, y, wy, mp, np);
+	Gauss(Lt, G, a1, a2, a3, x, wx, y, wy, mp, np);
 		
 	for (int i=0; i<3; i++) {
 		for (int j=i; j<3; j++) {
-			ij = Id(i,j);
+			ij = Id_Voigt[i][j];
 			for (int m=0; m<3; m++) {
 				for (int n=m; n<3; n++) {
-					mn = Id(m,n);
+					mn = Id_Voigt[m][n];
 					for (int p=0; p<3; p++) {
 						for (int q=0; q<3; q++) {
-							pq = Id(p,q);
-							ip = Id(i,p);
-							jq = Id(j,q);
-							jp = Id(j,p);
-							iq = Id(i,q);
+							pq = Id_Voigt[p][q];
+							ip = Id_Voigt[i][p];
+							jq = Id_Voigt[j][q];
+							jp = Id_Voigt[j][p];
+							iq = Id_Voigt[i][q];
 							T_II(ij,mn) = T_II(ij,mn)+I(pq,mn)*(G(ip,jq)+G(jp,iq));
 						}
 					}
@@ -362,12 +442,12 @@ mat T_II(const mat &Lt, const double &a1, const double &a2, const double &a3, co
 
 mat T_II(const mat &Lt, const double &a1, const double &a2, const double &a3, const int &mp, const int &np) {
     
-    vec x(mp);
-    vec wx(mp);
-    vec y(np);
-    vec wy(np);
-    points(x, wx, y, wy, mp, np);
-    return T_II(Lt, a1, a2, a3, x, wx, y, wy, mp, np);
+    return T_II(Lt, a1, a2, a3, *get_Gauss_points(mp, np));
+}
+
+mat T_II(const mat &Lt, const double &a1, const double &a2, const double &a3, const Gauss_points &gp) {
+    
+    return T_II(Lt, a1, a2, a3, gp.x, gp.wx, gp.y, gp.wy, gp.mp, gp.np);
 }
     
     
@@ -439,4 +519,123 @@ void points(vec &x, vec &wx, vec &y, vec &wy, const int &mp, const int &np)
 		
 }
 
+//Entry of the cache of numerical Eshelby/Hill tensors
+struct Eshelby_cache_entry
+{
+    int kind;           //0 for the Eshelby tensor, 1 for the Hill interaction tensor
+    std::size_t key;    //hash of the arguments, used for the exact match
+    double a1;
+    double a2;
+    double a3;
+    int mp;
+    int np;
+    mat66 Lt;
+    mat66 result;
+};
+
+static std::size_t Eshelby_cache_key(const int &kind, const mat &Lt, const double &a1, const double &a2, const double &a3, const int &mp, const int &np) {
+    
+    std::hash<double> hash_double;
+    std::size_t key = std::hash<int>()(kind);
+    auto combine = [&key](const std::size_t &h) {
+        key ^= h + 0x9e3779b9 + (key << 6) + (key >> 2);
+    };
+    combine(std::hash<int>()(mp));
+    combine(std::hash<int>()(np));
+    combine(hash_double(a1));
+    combine(hash_double(a2));
+    combine(hash_double(a3));
+    for (unsigned int i=0; i<Lt.n_elem; i++) {
+        combine(hash_double(Lt(i)));
+    }
+    return key;
+}
+
+static bool Eshelby_cache_match(const Eshelby_cache_entry &e, const int &kind, const std::size_t &key, const mat &Lt, const double &a1, const double &a2, const double &a3, const int &mp, const int &np, const double &tol) {
+    
+    if ((e.kind != kind)||(e.mp != mp)||(e.np != np))
+        return false;
+    
+    if (tol <= 0.) {
+        return ((e.key == key)&&(e.a1 == a1)&&(e.a2 == a2)&&(e.a3 == a3)&&(accu(e.Lt != Lt) == 0));
+    }
+    else {
+        if ((fabs(e.a1-a1) > tol*fabs(a1))||(fabs(e.a2-a2) > tol*fabs(a2))||(fabs(e.a3-a3) > tol*fabs(a3)))
+            return false;
+        return (abs(e.Lt - Lt).max() <= tol*abs(Lt).max());
+    }
+}
+
+static std::atomic<unsigned long> Eshelby_misses(0);
+
+//Closed-form tensor when possible, quadrature otherwise
+static mat Eshelby_compute(const int &kind, const mat &Lt, const double &a1, const double &a2, const double &a3, const Gauss_points &gp) {
+    
+    mat S;
+    if (Eshelby_closed_form(Lt, a1, a2, a3, S)) {
+        return (kind == 0) ? S : mat(S*inv(Lt));
+    }
+    return (kind == 0) ? Eshelby(Lt, a1, a2, a3, gp) : T_II(Lt, a1, a2, a3, gp);
+}
+
+static mat Eshelby_memo(const int &kind, const mat &Lt, const double &a1, const double &a2, const double &a3, const Gauss_points &gp, const double &tol) {
+    
+    if (eshelby_cache_size <= 0) {
+        Eshelby_misses++;
+        return Eshelby_compute(kind, Lt, a1, a2, a3, gp);
+    }
+    
+    static std::vector<Eshelby_cache_entry> cache;
+    static unsigned int next = 0;       //slot replaced when the cache is full (first in, first out)
+    static std::mutex cache_mutex;
+    
+    //The lookup comes first, so that a hit costs neither the quadrature nor the isotropy check of the closed form
+    std::size_t key = Eshelby_cache_key(kind, Lt, a1, a2, a3, gp.mp, gp.np);
+    {
+        std::lock_guard<std::mutex> lock(cache_mutex);
+        for (auto &e : cache) {
+            if (Eshelby_cache_match(e, kind, key, Lt, a1, a2, a3, gp.mp, gp.np, tol))
+                return e.result;
+        }
+    }
+    
+    //The tensor is computed outside of the lock
+    Eshelby_misses++;
+    Eshelby_cache_entry e;
+    e.kind = kind;
+    e.key = key;
+    e.a1 = a1;
+    e.a2 = a2;
+    e.a3 = a3;
+    e.mp = gp.mp;
+    e.np = gp.np;
+    e.Lt = Lt;
+    e.result = Eshelby_compute(kind, Lt, a1, a2, a3, gp);
+    
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    if (cache.size() < (unsigned int)eshelby_cache_size) {
+        cache.push_back(e);
+    }
+    else {
+        cache[next] = e;
+        next = (next+1)%cache.size();
+    }
+    return e.result;
+}
+
+mat Eshelby_cached(const mat &Lt, const double &a1, const double &a2, const double &a3, const Gauss_points &gp, const double &tol) {
+    
+    return Eshelby_memo(0, Lt, a1, a2, a3, gp, tol);
+}
+
+mat T_II_cached(const mat &Lt, const double &a1, const double &a2, const double &a3, const Gauss_points &gp, const double &tol) {
+    
+    return Eshelby_memo(1, Lt, a1, a2, a3, gp, tol);
+}
+
+unsigned long Eshelby_cache_misses() {
+    
+    return Eshelby_misses;
+}
+
 } //namespace smart
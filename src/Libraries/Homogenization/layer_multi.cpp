@@ -40,10 +40,11 @@ namespace smart{
 */
 
 //-------------------------------------------------------------
-layer_multi::layer_multi() : phase_multi(), Dnn(3,3), Dnt(3,3), dXn(3,3), dXt(3,3), sigma_hat(3), dzdx1(3)
+layer_multi::layer_multi() : phase_multi(), Dnn(3,3), Dnt(3,3), inv_Dnn(3,3), Lt_D(6,6), dXn(3,3), dXt(3,3), sigma_hat(3), dzdx1(3)
 //-------------------------------------------------------------
 {
-
+    //NaN ensures that the first call of fillD computes Dnn, Dnt and inv_Dnn
+    Lt_D.fill(datum::nan);
 }
 
 /*!
@@ -51,11 +52,12 @@ layer_multi::layer_multi() : phase_multi(), Dnn(3,3), Dnt(3,3), dXn(3,3), dXt(3,
 */
 
 //-------------------------------------------------------------
-layer_multi::layer_multi(const mat &mA, const mat &mA_start, const mat &mB, const mat &mB_start, const mat &mDnn, const mat &mDnt, const mat &mdXn, const mat &mdXt, const vec &msigma_hat, const vec &mdzdx1) : phase_multi(mA, mA_start, mB, mB_start), Dnn(3,3), Dnt(3,3), dXn(3,3), dXt(3,3), sigma_hat(3), dzdx1(3)
+layer_multi::layer_multi(const mat &mA, const mat &mA_start, const mat &mB, const mat &mB_start, const mat &mDnn, const mat &mDnt, const mat &mdXn, const mat &mdXt, const vec &msigma_hat, const vec &mdzdx1) : phase_multi(mA, mA_start, mB, mB_start), Dnn(3,3), Dnt(3,3), inv_Dnn(3,3), Lt_D(6,6), dXn(3,3), dXt(3,3), sigma_hat(3), dzdx1(3)
 //-------------------------------------------------------------
 {
     Dnn = mDnn;
     Dnt = mDnt;
+    Lt_D.fill(datum::nan);
     dXn = mdXn;
     dXt = mdXt;
     sigma_hat = msigma_hat;
@@ -73,10 +75,14 @@ layer_multi::layer_multi(const layer_multi& pc) : phase_multi(pc)
 {
     Dnn = pc.Dnn;
     Dnt = pc.Dnt;
+    inv_Dnn = pc.inv_Dnn;
+    Lt_D = pc.Lt_D;
     dXn = pc.dXn;
     dXt = pc.dXt;
     sigma_hat = pc.sigma_hat;
     dzdx1 = pc.dzdx1;
+    
+    rot_geom = pc.rot_geom;
 }
 
 /*!
@@ -89,6 +95,41 @@ layer_multi::layer_multi(const layer_multi& pc) : phase_multi(pc)
 layer_multi::~layer_multi() {}
 //-------------------------------------
 
+//-------------------------------------
+void layer_multi::fillD(const mat &Lt, const layer &lay)
+//-------------------------------------
+{
+    rot_geom.update(lay.psi_geom, lay.theta_geom, lay.phi_geom);
+    
+    if (all(vectorise(Lt == Lt_D)))
+        return;
+    
+    mat Lt_loc = rot_geom.g2l_L(Lt);
+    
+    Dnn(0,0) = Lt_loc(0,0);
+    Dnn(0,1) = Lt_loc(0,3);
+    Dnn(0,2) = Lt_loc(0,4);
+    Dnn(1,0) = Lt_loc(3,0);
+    Dnn(1,1) = Lt_loc(3,3);
+    Dnn(1,2) = Lt_loc(3,4);
+    Dnn(2,0) = Lt_loc(4,0);
+    Dnn(2,1) = Lt_loc(4,3);
+    Dnn(2,2) = Lt_loc(4,4);
+    
+    Dnt(0,0) = Lt_loc(0,1);
+    Dnt(0,1) = Lt_loc(0,2);
+    Dnt(0,2) = Lt_loc(0,5);
+    Dnt(1,0) = Lt_loc(3,1);
+    Dnt(1,1) = Lt_loc(3,2);
+    Dnt(1,2) = Lt_loc(3,5);
+    Dnt(2,0) = Lt_loc(4,1);
+    Dnt(2,1) = Lt_loc(4,2);
+    Dnt(2,2) = Lt_loc(4,5);
+    
+    inv_Dnn = inv(Dnn);
+    Lt_D = Lt;
+}
+    
 /*!
   \brief Standard operator = for phase_multi
 */
@@ -102,14 +143,20 @@ layer_multi& layer_multi::operator = (const layer_multi& pc)
     
     A_start = pc.A_start;
     B_start = pc.B_start;
+    nbiter = pc.nbiter;
+    nbiter_self_consistent = pc.nbiter_self_consistent;
     
     Dnn = pc.Dnn;
     Dnt = pc.Dnt;
+    inv_Dnn = pc.inv_Dnn;
+    Lt_D = pc.Lt_D;
     dXn = pc.dXn;
     dXt = pc.dXt;
     sigma_hat = pc.sigma_hat;
     dzdx1 = pc.dzdx1;
     
+    rot_geom = pc.rot_geom;
+    
     return *this;
 }
     
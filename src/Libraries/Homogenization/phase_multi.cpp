@@ -43,7 +43,8 @@ namespace smart{
 phase_multi::phase_multi() : A(6,6), A_start(6,6), B(6,6), B_start(6,6)
 //-------------------------------------------------------------
 {
-    
+    nbiter = 0;
+    nbiter_self_consistent = 0;
 }
 
 /*!
@@ -59,6 +60,9 @@ phase_multi::phase_multi(const mat &mA, const mat &mA_start, const mat &mB, cons
     
     A_start = mA_start;
     B_start = mB_start;
+    
+    nbiter = 0;
+    nbiter_self_consistent = 0;
 }
 
 /*!
@@ -76,6 +80,9 @@ phase_multi::phase_multi(const phase_multi& pc) : A(6,6), A_start(6,6), B(6,6),
     A_start = pc.A_start;
     B_start = pc.B_start;
     
+    nbiter = pc.nbiter;
+    nbiter_self_consistent = pc.nbiter_self_consistent;
+    
 }
 
 /*!
@@ -118,6 +125,9 @@ phase_multi& phase_multi::operator = (const phase_multi& pc)
     A_start = pc.A_start;
     B_start = pc.B_start;
     
+    nbiter = pc.nbiter;
+    nbiter_self_consistent = pc.nbiter_self_consistent;
+    
 	return *this;
 }
     
@@ -172,13 +172,16 @@ void run_identification_solver(const std::string &simul_type, const int &n_param
         boost::filesystem::create_directory(data_num_folder);
     }
         
-    /// Run the simulations corresponding to each individual
+    //The workers of the simulations, with their keys bound once for the whole identification
+    int nworkers = identification_workers(params, consts);
+    std::vector<key_bindings> kbs = bind_workers(nworkers, params, consts, nfiles, path_data, path_keys, materialfile);
+    
+    /// Run the simulations corresponding to each individual (in parallel if nthreads_identification > 1)
     /// The simulation input files should be ready!
+    std::vector<vec> vnum_pop = run_simulations(simul_type, geninit, nfiles, params, consts, data_num, data_exp, data_num_folder, data_num_name, path_data, path_keys, materialfile, sizev, kbs);
     for(int i=0; i<geninit.size(); i++) {
-        run_simulation(simul_type, geninit.pop[i], nfiles, params, consts, data_num, data_num_folder, data_num_name, path_data, path_keys, materialfile);
-        
         //Calculation of the cost function
-        geninit.pop[i].cout = calc_cost(vexp, vnum, W, data_num, data_exp, nfiles, sizev);
+        geninit.pop[i].cout = calcC(vexp, vnum_pop[i], W);
     }
     
     //Classification of bests
@@ -237,10 +240,10 @@ void run_identification_solver(const std::string &simul_type, const int &n_param
             genetic(gen[g], gensons, idnumber, probaMut, pertu, params);
             ///prepare the individuals to run
             
+            vnum_pop = run_simulations(simul_type, gensons, nfiles, params, consts, data_num, data_exp, data_num_folder, data_num_name, path_data, path_keys, materialfile, sizev, kbs);
             for(int i=0; i<gensons.size(); i++) {
-                run_simulation(simul_type, gensons.pop[i], nfiles, params, consts, data_num, data_num_folder, data_num_name, path_data, path_keys, materialfile);
                 //Calculation of the cost function
-                gensons.pop[i].cout = calc_cost(vexp, vnum, W, data_num, data_exp, nfiles, sizev);
+                gensons.pop[i].cout = calcC(vexp, vnum_pop[i], W);
             }
             
         }
@@ -248,7 +251,7 @@ void run_identification_solver(const std::string &simul_type, const int &n_param
             
             cost_gb_cost_n[i] = gen[g].pop[i].cout;
             
-            S = calc_sensi(gboys[g].pop[i], n_gboys, simul_type, nfiles, n_param, params, consts, vnum, data_num, data_exp, data_num_folder, data_num_name, path_data, path_keys, sizev, Dp_gb_n[i], materialfile);
+            S = calc_sensi(gboys[g].pop[i], n_gboys, simul_type, nfiles, n_param, params, consts, vnum, data_num, data_exp, data_num_folder, data_num_name, path_data, path_keys, sizev, Dp_gb_n[i], materialfile, kbs);
             gboys[g].pop[i].cout = calcC(vexp, vnum, W);
             p = gboys[g].pop[i].p;
             ///Compute the parameters increment
@@ -301,13 +304,17 @@ void run_identification_solver(const std::string &simul_type, const int &n_param
             boost::filesystem::remove_all(it->path());
         }
         
-        //Run the identified simulation and store results in the results folder
-        run_simulation(simul_type, gen[g].pop[0], nfiles, params, consts, data_num, path_results, data_num_name, path_data, path_keys, materialfile);
+        //Run the identified simulation and store results in the results folder, with the keys bound in memory if possible
+        if ((simul_type == "SOLVE")&&(kbs[0].in_memory))
+            launch_solver(gen[g].pop[0], nfiles, consts, kbs[0], path_results, data_num_name);
+        else
+            run_simulation(simul_type, gen[g].pop[0], nfiles, params, consts, data_num, path_results, data_num_name, path_data, path_keys, materialfile);
         
         copy_parameters(params, path_keys, path_results);
         apply_parameters(params, path_results);
     }
     
+    remove_workers(nworkers, path_data);
 }
 
 } //namespace smart
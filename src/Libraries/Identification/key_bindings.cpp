@@ -0,0 +1,268 @@
+/* This file is part of SMART+.
+ 
+ SMART+ is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ SMART+ is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with SMART+.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+
+///@file key_bindings.cpp
+///@brief Binding of the parameters and constants of an identification to the material properties and the loading paths
+///@version 1.0
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <algorithm>
+#include <assert.h>
+#include <math.h>
+#include <armadillo>
+
+#include <smartplus/parameter.hpp>
+#include <smartplus/Libraries/Identification/parameters.hpp>
+#include <smartplus/Libraries/Identification/constants.hpp>
+#include <smartplus/Libraries/Identification/script.hpp>
+#include <smartplus/Libraries/Identification/key_bindings.hpp>
+#include <smartplus/Libraries/Solver/read.hpp>
+
+using namespace std;
+using namespace arma;
+
+namespace smart{
+    
+//=====Private methods for key_bindings===================================
+
+//Conversion of a token of a file, false if it is not a number (for instance a key within an expression)
+static bool token_to_double(const string &token, double &value) {
+    
+    istringstream iss(token);
+    iss >> value;
+    return (!iss.fail() && iss.eof());
+}
+
+//=====Public methods for key_bindings============================================
+
+//@brief default constructor
+//-------------------------------------------------------------
+key_bindings::key_bindings()
+//-------------------------------------------------------------
+{
+    in_memory = false;
+    nstatev = 0;
+    psi_rve = 0.;
+    theta_rve = 0.;
+    phi_rve = 0.;
+}
+
+/*!
+  \brief Copy constructor
+  \param kb key_bindings object to duplicate
+*/
+
+//------------------------------------------------------
+key_bindings::key_bindings(const key_bindings& kb)
+//------------------------------------------------------
+{
+    in_memory = kb.in_memory;
+    umat_name = kb.umat_name;
+    nstatev = kb.nstatev;
+    psi_rve = kb.psi_rve;
+    theta_rve = kb.theta_rve;
+    phi_rve = kb.phi_rve;
+    props = kb.props;
+    props_params = kb.props_params;
+    props_consts = kb.props_consts;
+    blocks = kb.blocks;
+    T_init = kb.T_init;
+    so = kb.so;
+    contexts = kb.contexts;
+}
+
+/*!
+  \brief destructor
+*/
+
+key_bindings::~key_bindings() {}
+
+//-------------------------------------------------------------
+void key_bindings::bind(const vector<parameters> &params, const vector<constants> &consts, const int &nfiles, const string &path_data, const string &path_keys, const string &materialfile)
+//-------------------------------------------------------------
+{
+    in_memory = true;
+    props_params.clear();
+    props_consts.clear();
+    contexts.clear();
+    
+    vector<string> pathfiles(nfiles);
+    for (int i=0; i<nfiles; i++) {
+        pathfiles[i] = "path_id_" + to_string(i+1) + ".txt";
+    }
+    
+    //The parameters can only be bound to the material properties, the constants to the material properties and the loading paths
+    bool material_keyed = false;
+    for (auto &pa : params) {
+        for (auto &ifiles : pa.input_files) {
+            if (ifiles == materialfile)
+                material_keyed = true;
+            else
+                in_memory = false;
+        }
+    }
+    for (auto &co : consts) {
+        for (auto &ifiles : co.input_files) {
+            if (ifiles == materialfile)
+                material_keyed = true;
+            else if (find(pathfiles.begin(), pathfiles.end(), ifiles) == pathfiles.end())
+                in_memory = false;
+        }
+    }
+    if (!in_memory)
+        return;
+    
+    int nprops = 0;
+    if (material_keyed) {
+        
+        //Same reading as read_matprops, on the file with the keys
+        string path_materialfile = path_keys + "/" + materialfile;
+        ifstream propsmat;
+        propsmat.open(path_materialfile, ios::in);
+        if(!propsmat) {
+            cout << "Error: cannot open the file " << materialfile << " in the folder :" << path_keys << endl;
+            in_memory = false;
+            return;
+        }
+        
+        string buffer;
+        string token;
+        string psi_token;
+        string theta_token;
+        string phi_token;
+        propsmat >> buffer >> buffer >> umat_name >> buffer >> nprops >> buffer >> nstatev >> buffer >> buffer >> psi_token >> buffer >> theta_token >> buffer >> phi_token >> buffer;
+        
+        if (!(token_to_double(psi_token, psi_rve) && token_to_double(theta_token, theta_rve) && token_to_double(phi_token, phi_rve)))
+            in_memory = false;
+        
+        props = zeros(nprops);
+        for(int i=0; i<nprops; i++) {
+            propsmat >> buffer >> token;
+            
+            bool bound = false;
+            for (unsigned int k=0; (k<params.size())&&(!bound); k++) {
+                if (token == params[k].key) {
+                    props_params.push_back(make_pair(i, int(k)));
+                    bound = true;
+                }
+            }
+            for (unsigned int k=0; (k<consts.size())&&(!bound); k++) {
+                if (token == consts[k].key) {
+                    props_consts.push_back(make_pair(i, int(k)));
+                    bound = true;
+                }
+            }
+            if ((!bound)&&(!token_to_double(token, props(i))))
+                in_memory = false;
+        }
+        propsmat.close();
+        
+        psi_rve*=(pi/180.);
+        theta_rve*=(pi/180.);
+        phi_rve*=(pi/180.);
+    }
+    else {
+        read_matprops(umat_name, nprops, props, nstatev, psi_rve, theta_rve, phi_rve, path_data, materialfile);
+    }
+    if (!in_memory)
+        return;
+    
+    //The loading path of each test is read once, with the constants of the test applied in the data folder
+    blocks.resize(nfiles);
+    T_init = zeros(nfiles);
+    so.resize(nfiles);
+    vector<constants> consts_i = consts;
+    for (int i=0; i<nfiles; i++) {
+        for (unsigned int k=0; k<consts_i.size(); k++) {
+            consts_i[k].value = consts_i[k].input_values(i);
+        }
+        copy_constants(consts_i, path_keys, path_data);
+        apply_constants(consts_i, path_data);
+        
+        read_path(blocks[i], T_init(i), path_data, pathfiles[i]);
+        so[i] = solver_output(blocks[i].size());
+        read_output(so[i], blocks[i].size(), nstatev, path_data, "output.dat");
+        check_path_output(blocks[i], so[i]);
+    }
+    
+    //The runs of each test file keep their results in memory (see solver_context)
+    for (int i=0; i<nfiles; i++) {
+        contexts.push_back(solver_context(umat_name, nstatev, psi_rve, theta_rve, phi_rve, blocks[i], T_init(i), so[i]));
+    }
+}
+
+//-------------------------------------------------------------
+vec key_bindings::material_props(const vec &p, const vector<constants> &consts, const int &i) const
+//-------------------------------------------------------------
+{
+    vec props_i = props;
+    for (auto &b : props_params) {
+        props_i(b.first) = p(b.second);
+    }
+    for (auto &b : props_consts) {
+        props_i(b.first) = consts[b.second].input_values(i);
+    }
+    return props_i;
+}
+
+/*!
+  \brief Standard operator = for key_bindings objects
+*/
+
+//----------------------------------------------------------------------
+key_bindings& key_bindings::operator = (const key_bindings& kb)
+//----------------------------------------------------------------------
+{
+    in_memory = kb.in_memory;
+    umat_name = kb.umat_name;
+    nstatev = kb.nstatev;
+    psi_rve = kb.psi_rve;
+    theta_rve = kb.theta_rve;
+    phi_rve = kb.phi_rve;
+    props = kb.props;
+    props_params = kb.props_params;
+    props_consts = kb.props_consts;
+    blocks = kb.blocks;
+    T_init = kb.T_init;
+    so = kb.so;
+    contexts = kb.contexts;
+    
+	return *this;
+}
+
+//--------------------------------------------------------------------------
+ostream& operator << (ostream& s, const key_bindings& kb)
+//--------------------------------------------------------------------------
+{
+	s << "Display info on the key bindings\n";
+    s << "in memory: " << kb.in_memory << "\n";
+    s << "umat: " << kb.umat_name << ", nstatev: " << kb.nstatev << "\n";
+    for (auto &b : kb.props_params) {
+        s << "props(" << b.first << ") = parameter " << b.second << "\n";
+    }
+    for (auto &b : kb.props_consts) {
+        s << "props(" << b.first << ") = constant " << b.second << "\n";
+    }
+    s << "number of test files: " << kb.blocks.size() << "\n";
+    
+	return s;
+}
+
+} //namespace smart
@@ -206,6 +206,31 @@ void opti_data::import(string folder, int nexp)
     ifdata.clear();
 }
 
+//-------------------------------------------------------------
+void opti_data::import(const mat &records, int nexp)
+//-------------------------------------------------------------
+{
+    assert(ninfo>0);
+    assert(ncolumns>0);
+    
+    ndata = records.n_rows;
+    if ((nexp > 0)&&(ndata > nexp)) {
+        ndata = nexp;
+    }
+    //The run may have stopped before its first record
+    if (ndata == 0) {
+        data = zeros(0, ninfo);
+        return;
+    }
+    constructdata();
+    
+    for (int k=0; k<ninfo; k++) {
+        if ((c_data(k) < ncolumns)&&(c_data(k) < int(records.n_cols))) {
+            data.col(k) = records(span(0, ndata-1), c_data(k));
+        }
+    }
+}
+
 /*!
   \brief Standard operator = for opti_data
 */
@@ -30,6 +30,7 @@
 #include <boost/filesystem.hpp>
 #include <boost/algorithm/string/replace.hpp>
 
+#include <smartplus/parameter.hpp>
 #include <smartplus/Libraries/Identification/parameters.hpp>
 #include <smartplus/Libraries/Identification/constants.hpp>
 #include <smartplus/Libraries/Identification/generation.hpp>
@@ -197,7 +198,52 @@ void launch_solver(const individual &ind, const int &nfiles, vector<parameters>
     }
 }
     
-void run_simulation(const string &simul_type, const individual &ind, const int &nfiles, vector<parameters> &params, vector<constants> &consts, vector<opti_data> &data_num, const string &folder, const string &name, const string &path_data, const string &path_keys, const string &materialfile) {
+void launch_solver(const individual &ind, const int &nfiles, const vector<constants> &consts, key_bindings &kb, const string &path_results, const string &name)
+{
+	string outputfile;
+    string simulfile;
+    
+    string name_ext = name.substr(name.length()-4,name.length());
+    string name_root = name.substr(0,name.length()-4); //to remove the extension
+    
+    for (int i = 0; i<nfiles; i++) {
+        ///Creating the right output filenames
+        outputfile = name_root + "_" + to_string(ind.id) + "_" + to_string(i+1) + name_ext;
+        
+        //The parameters and constants are patched in the material properties, the loading path of the file has been read with its constants
+        vec props = kb.material_props(ind.p, consts, i);
+        
+        ///Launching the solver with relevant parameters
+        solver(kb.umat_name, props, kb.nstatev, kb.psi_rve, kb.theta_rve, kb.phi_rve, kb.blocks[i], kb.T_init(i), kb.so[i], path_results, outputfile);
+        
+        //Get the simulation files according to the proper name
+        outputfile = path_results + "/" + name_root + + "_" + to_string(ind.id) + "_" + to_string(i+1) + "_global-0" + name_ext;
+        simulfile = path_results + "/" + name_root + + "_" + to_string(ind.id)  +"_" + to_string(i+1) + name_ext;
+        
+        boost::filesystem::copy_file(outputfile,simulfile,boost::filesystem::copy_option::overwrite_if_exists);
+    }
+}
+    
+void launch_solver(const individual &ind, const int &nfiles, const vector<constants> &consts, key_bindings &kb, vector<opti_data> &data_num)
+{
+    for (int i = 0; i<nfiles; i++) {
+        
+        //The parameters and constants are patched in the material properties, the loading path of the file has been read with its constants
+        vec props = kb.material_props(ind.p, consts, i);
+        
+        ///Launching the solver, the records are kept in memory and the selected columns imported from them
+        mat records = kb.contexts[i].run(props);
+        data_num[i].import(records);
+    }
+}
+    
+void run_simulation(const string &simul_type, const individual &ind, const int &nfiles, vector<parameters> &params, vector<constants> &consts, vector<opti_data> &data_num, const string &folder, const string &name, const string &path_data, const string &path_keys, const string &materialfile, key_bindings *kb) {
+    
+    //Nothing is written: the numerical data are imported from the results of the runs
+    if ((simul_type == "SOLVE")&&(kb != nullptr)&&(kb->in_memory)&&(memory_results_identification == 1)) {
+        launch_solver(ind, nfiles, consts, *kb, data_num);
+        return;
+    }
     
     //In the simulation run, make sure that we remove all the temporary files
     boost::filesystem::path path_to_remove(folder);
@@ -205,13 +251,16 @@ void run_simulation(const string &simul_type, const individual &ind, const int &
         boost::filesystem::remove_all(it->path());
     }
     
-    std::map<std::string, int> list_simul;
-    list_simul = {{"SOLVE",1}};
+    static const std::map<std::string, int> list_simul = {{"SOLVE",1}};
+    auto simul = list_simul.find(simul_type);
     
-    switch (list_simul[simul_type]) {
+    switch ((simul != list_simul.end()) ? simul->second : 0) {
             
         case 1: {
-            launch_solver(ind, nfiles, params, consts, folder, name, path_data, path_keys, materialfile);
+            if ((kb != nullptr)&&(kb->in_memory))
+                launch_solver(ind, nfiles, consts, *kb, folder, name);
+            else
+                launch_solver(ind, nfiles, params, consts, folder, name, path_data, path_keys, materialfile);
             break;
         }
         default: {
@@ -234,13 +283,101 @@ void run_simulation(const string &simul_type, const individual &ind, const int &
     
 }
     
+int identification_workers(const vector<parameters> &params, const vector<constants> &consts) {
+    
+    if (nthreads_identification <= 1)
+        return 1;
+    
+    static const std::vector<string> microstructure_files = {"Nphases", "Nlayers", "Nellipsoids", "Ncylinders"};
+    std::vector<string> input_files;
+    for (auto &p : params)
+        input_files.insert(input_files.end(), p.input_files.begin(), p.input_files.end());
+    for (auto &c : consts)
+        input_files.insert(input_files.end(), c.input_files.begin(), c.input_files.end());
+    
+    for (auto &f : input_files) {
+        for (auto &m : microstructure_files) {
+            if (f.compare(0, m.length(), m) == 0) {
+                cout << "The key file " << f << " is a microstructure file, read in data/ by the multiphase laws: the simulations are run by a single worker\n";
+                return 1;
+            }
+        }
+    }
+    return int(nthreads_identification);
+}
+    
+std::vector<key_bindings> bind_workers(const int &nworkers, const vector<parameters> &params, const vector<constants> &consts, const int &nfiles, const string &path_data, const string &path_keys, const string &materialfile) {
+    
+    std::vector<key_bindings> kbs(nworkers);
+    for (int k=0; k<nworkers; k++) {
+        
+        string path_data_k = path_data;
+        if (nworkers > 1) {
+            //Copy of the data folder, the keyed files are then replaced in it by launch_solver
+            path_data_k = path_data + "_" + to_string(k+1);
+            boost::filesystem::create_directories(path_data_k);
+            for (boost::filesystem::directory_iterator end_dir_it, it(path_data); it!=end_dir_it; ++it) {
+                if (boost::filesystem::is_regular_file(it->path()))
+                    boost::filesystem::copy_file(it->path(), path_data_k + "/" + it->path().filename().string(), boost::filesystem::copy_option::overwrite_if_exists);
+            }
+        }
+        
+        if (key_binding_identification == 1)
+            kbs[k].bind(params, consts, nfiles, path_data_k, path_keys, materialfile);
+    }
+    return kbs;
+}
+    
+void remove_workers(const int &nworkers, const string &path_data) {
+    
+    if (nworkers > 1) {
+        for (int k=0; k<nworkers; k++) {
+            boost::filesystem::remove_all(path_data + "_" + to_string(k+1));
+        }
+    }
+}
+    
+std::vector<vec> run_simulations(const string &simul_type, const generation &gen, const int &nfiles, const vector<parameters> &params, const vector<constants> &consts, const vector<opti_data> &data_num, const vector<opti_data> &data_exp, const string &folder, const string &name, const string &path_data, const string &path_keys, const string &materialfile, const int &sizev, std::vector<key_bindings> &kbs) {
+    
+    int npop = gen.size();
+    std::vector<vec> vnum(npop);
+    int nworkers = int(kbs.size());
+    int nactive = min(nworkers, npop);
+    
+    //The individuals are independent: the worker k runs the individuals k, k+nactive, ... so that the numerical vectors do not depend on the number of workers
+    #pragma omp parallel for num_threads(nactive) if(nactive > 1) schedule(static,1)
+    for (int k=0; k<nactive; k++) {
+        
+        vector<parameters> params_k = params;
+        vector<constants> consts_k = consts;
+        vector<opti_data> data_num_k = data_num;
+        string folder_k = folder;
+        string path_data_k = path_data;
+        
+        if (nworkers > 1) {
+            folder_k = folder + "/results_" + to_string(k+1);
+            path_data_k = path_data + "_" + to_string(k+1);
+            boost::filesystem::create_directories(folder_k);
+        }
+        
+        for (int i=k; i<npop; i+=nactive) {
+            run_simulation(simul_type, gen.pop[i], nfiles, params_k, consts_k, data_num_k, folder_k, name, path_data_k, path_keys, materialfile, &kbs[k]);
+            vnum[i] = calcV(data_num_k, data_exp, nfiles, sizev);
+        }
+        
+        if (nworkers > 1)
+            boost::filesystem::remove_all(folder_k);
+    }
+    return vnum;
+}
+    
 double calc_cost(const vec &vexp, vec &vnum, const vec &W, const vector<opti_data> &data_num, const vector<opti_data> &data_exp, const int &nfiles, const int &sizev) {
 
     vnum = calcV(data_num, data_exp, nfiles, sizev);    
     return calcC(vexp, vnum, W);
 }
      
-mat calc_sensi(const individual &gboy, generation &n_gboy, const string &simul_type, const int &nfiles, const int &n_param, vector<parameters> &params, vector<constants> &consts, vec &vnum0, vector<opti_data> &data_num, vector<opti_data> &data_exp, const string &folder, const string &name, const string &path_data, const string &path_keys, const int &sizev, const vec &Dp_n, const string &materialfile) {
+mat calc_sensi(const individual &gboy, generation &n_gboy, const string &simul_type, const int &nfiles, const int &n_param, vector<parameters> &params, vector<constants> &consts, vec &vnum0, vector<opti_data> &data_num, vector<opti_data> &data_exp, const string &folder, const string &name, const string &path_data, const string &path_keys, const int &sizev, const vec &Dp_n, const string &materialfile, std::vector<key_bindings> &kbs) {
     
     //delta
     vec delta = 0.01*ones(n_param);
@@ -248,8 +385,9 @@ mat calc_sensi(const individual &gboy, generation &n_gboy, const string &simul_t
     mat S = zeros(sizev,n_param);
     //genrun part of the gradient
     
-    run_simulation(simul_type, gboy, nfiles, params, consts, data_num, folder, name, path_data, path_keys, materialfile);
-    vnum0 = calcV(data_num, data_exp, nfiles, sizev);
+    generation gen_gboy;
+    gen_gboy.pop.push_back(gboy);
+    vnum0 = run_simulations(simul_type, gen_gboy, nfiles, params, consts, data_num, data_exp, folder, name, path_data, path_keys, materialfile, sizev, kbs)[0];
     
     for(int j=0; j<n_param; j++) {
         n_gboy.pop[j].p = gboy.p;
@@ -264,12 +402,10 @@ mat calc_sensi(const individual &gboy, generation &n_gboy, const string &simul_t
         }
     }
     
+    //run the simulations of the perturbed individuals
+    std::vector<vec> vnum = run_simulations(simul_type, n_gboy, nfiles, params, consts, data_num, data_exp, folder, name, path_data, path_keys, materialfile, sizev, kbs);
     for(int j=0; j<n_param; j++) {
-        //run the simulation
-        run_simulation(simul_type, n_gboy.pop[j], nfiles, params, consts, data_num, folder, name, path_data, path_keys, materialfile);
-        vec vnum = calcV(data_num, data_exp, nfiles, sizev);
-        
-        calcS(S, vnum, vnum0, j, delta);
+        calcS(S, vnum[j], vnum0, j, delta);
     }
     return S;
 }
@@ -0,0 +1,124 @@
+/* This file is part of SMART+.
+ 
+ SMART+ is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ SMART+ is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with SMART+.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+///@file anderson.cpp
+///@brief Anderson acceleration of a fixed-point iteration x = G(x)
+///@version 1.0
+
+#include <iostream>
+#include <assert.h>
+#include <armadillo>
+#include <smartplus/Libraries/Maths/anderson.hpp>
+
+using namespace std;
+using namespace arma;
+
+namespace smart{
+
+//=====Private methods for Anderson_mixing===================================
+
+//=====Public methods for Anderson_mixing============================================
+
+/*!
+  \brief default constructor
+  \param mdepth maximal number of previous iterates used for the mixing
+*/
+
+//-------------------------------------------------------------
+Anderson_mixing::Anderson_mixing(const int &mdepth)
+//-------------------------------------------------------------
+{
+    assert(mdepth >= 0);
+    depth = mdepth;
+    nhist = 0;
+}
+
+/*!
+  \brief Destructor
+*/
+
+//-------------------------------------
+Anderson_mixing::~Anderson_mixing() {}
+//-------------------------------------
+
+//-------------------------------------------------------------
+void Anderson_mixing::reset()
+//-------------------------------------------------------------
+{
+    nhist = 0;
+    dF.reset();
+    dG.reset();
+    f_prev.reset();
+    g_prev.reset();
+}
+
+/*!
+  \brief Next iterate of the fixed-point iteration x = G(x)
+  \param x the current iterate
+  \param g its image G(x)
+  The residual f = G(x) - x is minimized over the span of the last depth differences of residuals:
+  gamma = argmin ||f - dF gamma||, and the next iterate is G(x) - dG gamma (Walker & Ni, 2011).
+  Without history (first call, or depth = 0) this is the plain iterate G(x).
+*/
+
+//-------------------------------------------------------------
+vec Anderson_mixing::update(const vec &x, const vec &g)
+//-------------------------------------------------------------
+{
+    assert(x.n_elem == g.n_elem);
+    vec f = g - x;
+    
+    if ((depth > 0)&&(f_prev.n_elem == f.n_elem)) {
+        if (nhist == depth) {
+            dF.shed_col(0);
+            dG.shed_col(0);
+            nhist--;
+        }
+        dF = join_rows(dF, f - f_prev);
+        dG = join_rows(dG, g - g_prev);
+        nhist++;
+    }
+    f_prev = f;
+    g_prev = g;
+    
+    if (nhist == 0)
+        return g;
+    
+    //Least-squares coefficients; an ill-conditioned history is dropped and the plain iterate is used
+    vec gamma;
+    bool success = solve(gamma, dF, f);
+    if ((!success)||(!gamma.is_finite())) {
+        reset();
+        f_prev = f;
+        g_prev = g;
+        return g;
+    }
+    return g - dG*gamma;
+}
+
+//--------------------------------------------------------------------------
+ostream& operator << (ostream& s, const Anderson_mixing& am)
+//--------------------------------------------------------------------------
+{
+    s << "Display Anderson mixing:\n";
+    s << "depth: " << am.depth << "\n";
+    s << "number of stored differences: " << am.nhist << "\n";
+    s << "\n\n";
+    
+    return s;
+}
+
+} //namespace smart
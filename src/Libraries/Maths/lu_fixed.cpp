@@ -0,0 +1,122 @@
+/* This file is part of SMART+.
+ 
+ SMART+ is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ SMART+ is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with SMART+.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+
+///@file lu_fixed.cpp
+///@brief LU decomposition of small linear systems of fixed size, on stack storage
+///@version 1.0
+
+#include <iostream>
+#include <assert.h>
+#include <math.h>
+#include <armadillo>
+#include <smartplus/Libraries/Maths/lu_fixed.hpp>
+
+using namespace std;
+using namespace arma;
+
+namespace smart{
+
+//@brief default constructor
+//-------------------------------------------------------------
+template<int N> LU_fixed<N>::LU_fixed()
+//-------------------------------------------------------------
+{
+    zeros();
+}
+
+//-------------------------------------------------------------
+template<int N> void LU_fixed<N>::zeros()
+//-------------------------------------------------------------
+{
+    for (int i=0; i<N*N; i++)
+        a[i] = 0.;
+    for (int i=0; i<N; i++)
+        piv[i] = i;
+    factorized = false;
+}
+
+//-------------------------------------------------------------
+template<int N> bool LU_fixed<N>::factorize()
+//-------------------------------------------------------------
+{
+    for (int i=0; i<N; i++)
+        piv[i] = i;
+    
+    for (int k=0; k<N; k++) {
+        //Partial pivoting on the column k
+        int p = k;
+        double amax = fabs(a[k*N+k]);
+        for (int i=k+1; i<N; i++) {
+            if (fabs(a[i*N+k]) > amax) {
+                amax = fabs(a[i*N+k]);
+                p = i;
+            }
+        }
+        if (amax == 0.) {
+            factorized = false;
+            return false;
+        }
+        if (p != k) {
+            for (int j=0; j<N; j++) {
+                double temp = a[k*N+j];
+                a[k*N+j] = a[p*N+j];
+                a[p*N+j] = temp;
+            }
+            int itemp = piv[k];
+            piv[k] = piv[p];
+            piv[p] = itemp;
+        }
+        
+        //Elimination below the pivot, the multipliers are stored in the lower part
+        for (int i=k+1; i<N; i++) {
+            a[i*N+k] /= a[k*N+k];
+            for (int j=k+1; j<N; j++) {
+                a[i*N+j] -= a[i*N+k]*a[k*N+j];
+            }
+        }
+    }
+    factorized = true;
+    return true;
+}
+
+//-------------------------------------------------------------
+template<int N> void LU_fixed<N>::solve(const vec &b, vec &x) const
+//-------------------------------------------------------------
+{
+    assert(factorized);
+    assert(b.n_elem >= unsigned(N));
+    assert(x.n_elem >= unsigned(N));
+    
+    double y[N];
+    for (int i=0; i<N; i++) {
+        y[i] = b(piv[i]);
+        for (int j=0; j<i; j++)
+            y[i] -= a[i*N+j]*y[j];
+    }
+    for (int i=N-1; i>=0; i--) {
+        for (int j=i+1; j<N; j++)
+            y[i] -= a[i*N+j]*y[j];
+        y[i] /= a[i*N+i];
+    }
+    for (int i=0; i<N; i++)
+        x(i) = y[i];
+}
+
+template class LU_fixed<6>;
+template class LU_fixed<7>;
+
+} //namespace smart
@@ -23,6 +23,7 @@
 #include <armadillo>
 #include <smartplus/parameter.hpp>
 #include <smartplus/Libraries/Continuum_Mechanics/contimech.hpp>
+#include <smartplus/Libraries/Continuum_Mechanics/voigt.hpp>
 
 using namespace std;
 using namespace arma;
@@ -190,7 +191,7 @@ mat fillQS(const double &alpha, const int &axis) {
 	return QS;		
 }
 
-mat fillQS(const mat &DR) {
+void fillQS(mat &QS, const mat &DR) {
     
     double a = DR(0,0);
     double d = DR(0,1);
@@ -202,7 +203,7 @@ mat fillQS(const mat &DR) {
     double f = DR(2,1);
     double i = DR(2,2);
     
-    mat QS= zeros(6,6);
+    QS.zeros(6,6);
     QS(0,0) = a*a;
     QS(0,1) = d*d;
     QS(0,2) = g*g;
@@ -239,7 +240,12 @@ mat fillQS(const mat &DR) {
     QS(5,3) = c*e+b*f;
     QS(5,4) = c*h+b*i;
     QS(5,5) = f*h+e*i;
+}
+
+mat fillQS(const mat &DR) {
     
+    mat QS(6,6);
+    fillQS(QS, DR);
     return QS;
 }
     
@@ -374,7 +380,7 @@ mat fillQE(const double &alpha, const int &axis) {
 	return QE;		
 }
     
-mat fillQE(const mat &DR) {
+void fillQE(mat &QE, const mat &DR) {
     
     double a = DR(0,0);
     double d = DR(0,1);
@@ -386,7 +392,7 @@ mat fillQE(const mat &DR) {
     double f = DR(2,1);
     double i = DR(2,2);
     
-    mat QE= zeros(6,6);
+    QE.zeros(6,6);
     QE(0,0) = a*a;
     QE(0,1) = d*d;
     QE(0,2) = g*g;
@@ -423,7 +429,12 @@ mat fillQE(const mat &DR) {
     QE(5,3) = c*e+b*f;
     QE(5,4) = c*h+b*i;
     QE(5,5) = f*h+e*i;
+}
+
+mat fillQE(const mat &DR) {
     
+    mat QE(6,6);
+    fillQE(QE, DR);
     return QE;
 }
 
@@ -500,7 +511,8 @@ vec rotate_stress(const vec &V, const double &alpha, const int &axis) {
 //To rotate a stress vector (6)
 vec rotate_stress(const vec &V, const mat &DR) {
     
-    mat QS = fillQS(DR);
+    mat66 QS;
+    fillQS(QS, DR);
     return QS*V;
 }
     
@@ -513,7 +525,8 @@ vec rotate_strain(const vec &V, const double &alpha, const int &axis) {
 
 vec rotate_strain(const vec &V, const mat &DR) {
     
-    mat QE = fillQE(DR);
+    mat66 QE;
+    fillQE(QE, DR);
     return QE*V;
 }
     
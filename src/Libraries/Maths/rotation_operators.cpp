@@ -0,0 +1,234 @@
+/* This file is part of SMART+.
+ 
+ SMART+ is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ SMART+ is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with SMART+.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+
+///@file rotation_operators.cpp
+///@brief Composed rotation operators of a set of Euler angles (psi, theta, phi), computed once and reused
+///@version 1.0
+
+#include <iostream>
+#include <math.h>
+#include <armadillo>
+#include <smartplus/parameter.hpp>
+#include <smartplus/Libraries/Maths/rotation.hpp>
+#include <smartplus/Libraries/Maths/rotation_operators.hpp>
+
+using namespace std;
+using namespace arma;
+
+namespace smart{
+
+//=====Private methods for rotation_operators===================================
+
+//=====Public methods for rotation_operators============================================
+
+/*!
+  \brief default constructor
+*/
+
+//-------------------------------------------------------------
+rotation_operators::rotation_operators()
+//-------------------------------------------------------------
+{
+    //NaN angles ensure that the first call of update computes the operators
+    psi = datum::nan;
+    theta = datum::nan;
+    phi = datum::nan;
+    identity = false;
+    
+    QS_g2l.eye();
+    QE_g2l.eye();
+    QS_l2g.eye();
+    QE_l2g.eye();
+}
+
+/*!
+  \brief Constructor with parameters
+  \f$ \textbf{Examples :} \f$ \n
+*/
+
+//-------------------------------------------------------------
+rotation_operators::rotation_operators(const double &mpsi, const double &mtheta, const double &mphi) : rotation_operators()
+//-------------------------------------------------------------
+{
+    update(mpsi, mtheta, mphi);
+}
+
+/*!
+  \brief Copy constructor
+  \param s rotation_operators object to duplicate
+*/
+
+//------------------------------------------------------
+rotation_operators::rotation_operators(const rotation_operators& ro)
+//------------------------------------------------------
+{
+    psi = ro.psi;
+    theta = ro.theta;
+    phi = ro.phi;
+    identity = ro.identity;
+    
+    QS_g2l = ro.QS_g2l;
+    QE_g2l = ro.QE_g2l;
+    QS_l2g = ro.QS_l2g;
+    QE_l2g = ro.QE_l2g;
+}
+
+/*!
+  \brief Destructor
+*/
+
+//-------------------------------------
+rotation_operators::~rotation_operators() {}
+//-------------------------------------
+
+//-------------------------------------------------------------
+void rotation_operators::update(const double &mpsi, const double &mtheta, const double &mphi)
+//-------------------------------------------------------------
+{
+    if ((mpsi == psi) && (mtheta == theta) && (mphi == phi))
+        return;
+    
+    psi = mpsi;
+    theta = mtheta;
+    phi = mphi;
+    
+    //The global to local rotation applies psi, then theta, then phi (see rotate_g2l_L)
+    QS_g2l.eye();
+    QE_g2l.eye();
+    identity = true;
+    if(fabs(psi) > iota) {
+        QS_g2l = fillQS(psi, axis_psi)*QS_g2l;
+        QE_g2l = fillQE(psi, axis_psi)*QE_g2l;
+        identity = false;
+    }
+    if(fabs(theta) > iota) {
+        QS_g2l = fillQS(theta, axis_theta)*QS_g2l;
+        QE_g2l = fillQE(theta, axis_theta)*QE_g2l;
+        identity = false;
+    }
+    if(fabs(phi) > iota) {
+        QS_g2l = fillQS(phi, axis_phi)*QS_g2l;
+        QE_g2l = fillQE(phi, axis_phi)*QE_g2l;
+        identity = false;
+    }
+    
+    //Since the work is invariant, the inverse of QS is trans(QE) and the inverse of QE is trans(QS)
+    QS_l2g = trans(QE_g2l);
+    QE_l2g = trans(QS_g2l);
+}
+
+//-------------------------------------------------------------
+mat rotation_operators::g2l_L(const mat &L) const
+//-------------------------------------------------------------
+{
+    if (identity)
+        return L;
+    return QS_g2l*(L*trans(QS_g2l));
+}
+
+//-------------------------------------------------------------
+mat rotation_operators::l2g_L(const mat &L) const
+//-------------------------------------------------------------
+{
+    if (identity)
+        return L;
+    return QS_l2g*(L*trans(QS_l2g));
+}
+
+//-------------------------------------------------------------
+mat rotation_operators::g2l_M(const mat &M) const
+//-------------------------------------------------------------
+{
+    if (identity)
+        return M;
+    return QE_g2l*(M*trans(QE_g2l));
+}
+
+//-------------------------------------------------------------
+mat rotation_operators::l2g_M(const mat &M) const
+//-------------------------------------------------------------
+{
+    if (identity)
+        return M;
+    return QE_l2g*(M*trans(QE_l2g));
+}
+
+//-------------------------------------------------------------
+mat rotation_operators::g2l_A(const mat &A) const
+//-------------------------------------------------------------
+{
+    if (identity)
+        return A;
+    return QE_g2l*(A*trans(QS_g2l));
+}
+
+//-------------------------------------------------------------
+mat rotation_operators::l2g_A(const mat &A) const
+//-------------------------------------------------------------
+{
+    if (identity)
+        return A;
+    return QE_l2g*(A*trans(QS_l2g));
+}
+
+//-------------------------------------------------------------
+mat rotation_operators::g2l_B(const mat &B) const
+//-------------------------------------------------------------
+{
+    if (identity)
+        return B;
+    return QS_g2l*(B*trans(QE_g2l));
+}
+
+//-------------------------------------------------------------
+mat rotation_operators::l2g_B(const mat &B) const
+//-------------------------------------------------------------
+{
+    if (identity)
+        return B;
+    return QS_l2g*(B*trans(QE_l2g));
+}
+
+//----------------------------------------------------------------------
+rotation_operators& rotation_operators::operator = (const rotation_operators& ro)
+//----------------------------------------------------------------------
+{
+    psi = ro.psi;
+    theta = ro.theta;
+    phi = ro.phi;
+    identity = ro.identity;
+    
+    QS_g2l = ro.QS_g2l;
+    QE_g2l = ro.QE_g2l;
+    QS_l2g = ro.QS_l2g;
+    QE_l2g = ro.QE_l2g;
+    
+    return *this;
+}
+
+//--------------------------------------------------------------------------
+ostream& operator << (ostream& s, const rotation_operators& ro)
+//--------------------------------------------------------------------------
+{
+    s << "Rotation operators: psi = " << ro.psi << "\t theta = " << ro.theta << "\t phi = " << ro.phi << "\n";
+    s << "QS_g2l: \n" << ro.QS_g2l << "\n";
+    s << "QE_g2l: \n" << ro.QE_g2l << "\n";
+    
+    return s;
+}
+
+} //namespace smart
@@ -25,6 +25,7 @@
 #include <assert.h>
 #include <armadillo>
 #include <smartplus/Libraries/Phase/material_characteristics.hpp>
+#include <smartplus/Umat/umat_registry.hpp>
 
 using namespace std;
 using namespace arma;
@@ -44,6 +45,7 @@ material_characteristics::material_characteristics()
 //-------------------------------------------------------------
 {
 	number=-1;
+    umat_id = umat_unknown;
     save = 0;
     
 	psi_mat=0.;
@@ -70,6 +72,7 @@ material_characteristics::material_characteristics(const int &n, const bool &ini
 	assert(n>0);
   
 	number = -1;
+    umat_id = umat_unknown;
     save = 0;
     
 	psi_mat=0.;
@@ -101,6 +104,7 @@ material_characteristics::material_characteristics(const int &mnumber, const str
 	
 	number = mnumber;
 	umat_name = mumat_name;
+    umat_id = find_umat(umat_name);
     save = msave;
     
     psi_mat = mpsi_mat;
@@ -122,11 +126,13 @@ material_characteristics::material_characteristics(const material_characteristic
 {
 	number = sv.number;
 	umat_name = sv.umat_name;
+    umat_id = sv.umat_id;
     save = sv.save;
 
     psi_mat = sv.psi_mat;
 	theta_mat = sv.theta_mat;
 	phi_mat = sv.phi_mat;
+    rot_mat = sv.rot_mat;
     
 	nprops = sv.nprops;
 	props = sv.props;
@@ -177,6 +183,7 @@ void material_characteristics::update(const int &mnumber, const string &mumat_na
     
     number = mnumber;
     umat_name = mumat_name;
+    umat_id = find_umat(umat_name);
     save = msave;
     
     psi_mat = mpsi_mat;
@@ -187,6 +194,14 @@ void material_characteristics::update(const int &mnumber, const string &mumat_na
     props = mprops;
 }
     
+//-------------------------------------------------------------
+const rotation_operators& material_characteristics::update_rotation()
+//-------------------------------------------------------------
+{
+    rot_mat.update(psi_mat, theta_mat, phi_mat);
+    return rot_mat;
+}
+
 //----------------------------------------------------------------------
 material_characteristics& material_characteristics::operator = (const material_characteristics& sv)
 //----------------------------------------------------------------------
@@ -195,11 +210,13 @@ material_characteristics& material_characteristics::operator = (const material_c
 
 	number = sv.number;
 	umat_name = sv.umat_name;
+    umat_id = sv.umat_id;
     save = sv.save;
     
     psi_mat = sv.psi_mat;
 	theta_mat = sv.theta_mat;
 	phi_mat = sv.phi_mat;
+    rot_mat = sv.rot_mat;
 		
 	nprops = sv.nprops;
 	props = sv.props;
@@ -107,6 +107,7 @@ phase_characteristics::phase_characteristics(const phase_characteristics& pc)
     sptr_sv_local = pc.sptr_sv_local;
     sptr_out_global = pc.sptr_out_global;
     sptr_out_local = pc.sptr_out_local;
+    sptr_writer = pc.sptr_writer;
     
     sub_phases = pc.sub_phases;
     sub_phases_file = pc.sub_phases_file;
@@ -129,7 +130,7 @@ phase_characteristics::~phase_characteristics() {}
   
     
 //-------------------------------------------------------------
-void phase_characteristics::construct(const int &mshape_type, const int &msv_type)
+void phase_characteristics::construct(const int &mshape_type, const int &msv_type, const bool &alloc_sv)
 //-------------------------------------------------------------
 {
     assert(msv_type > 0);
@@ -166,6 +167,10 @@ void phase_characteristics::construct(const int &mshape_type, const int &msv_typ
         }
     }
     
+    //The state variables are allocated by the caller (see sub_phases_construct)
+    if (!alloc_sv)
+        return;
+    
     //Switch case for the state_variables type of the phase
     switch (sv_type) {
         case 0: {
@@ -203,7 +208,34 @@ void phase_characteristics::sub_phases_construct(const int &nphases, const int &
 
     //Second, for each component of the sub_phase vector we construct the phases
     for (int i=0; i<nphases; i++) {
-        sub_phases[i].construct(mshape_type, msv_type);
+        sub_phases[i].construct(mshape_type, msv_type, false);
+    }
+    
+    //Third, the state variables objects of the sub-phases of this phase live in a single contiguous arena (global and local state of a sub-phase side by side).
+    //Each sub-phase holds aliasing pointers into it, that keep the arena alive. The 6-vectors and 6x6 operators are fixed-size and stored inline,
+    //statev (and its start value) remains a heap buffer of each state variables object.
+    switch (msv_type) {
+        case 1: {
+            auto arena = std::make_shared<std::vector<state_variables_M> >(2*nphases);
+            for (int i=0; i<nphases; i++) {
+                sub_phases[i].sptr_sv_global = std::shared_ptr<state_variables>(arena, &(*arena)[2*i]);
+                sub_phases[i].sptr_sv_local = std::shared_ptr<state_variables>(arena, &(*arena)[2*i+1]);
+            }
+            break;
+        }
+        case 2: {
+            auto arena = std::make_shared<std::vector<state_variables_T> >(2*nphases);
+            for (int i=0; i<nphases; i++) {
+                sub_phases[i].sptr_sv_global = std::shared_ptr<state_variables>(arena, &(*arena)[2*i]);
+                sub_phases[i].sptr_sv_local = std::shared_ptr<state_variables>(arena, &(*arena)[2*i+1]);
+            }
+            break;
+        }
+        default: {
+            cout << "error: The state_variable type does not correspond (1 for Mechanical, 2 for Thermomechanical)\n";
+            exit(0);
+            break;
+        }
     }
 }
     
@@ -214,15 +246,15 @@ void phase_characteristics::to_start()
     
     switch (sv_type) {
         case 1: {
-            auto sv_M_g = std::dynamic_pointer_cast<state_variables_M>(sptr_sv_global);
-            auto sv_M_l = std::dynamic_pointer_cast<state_variables_M>(sptr_sv_local);
+            auto sv_M_g = sv_global_as<state_variables_M>();
+            auto sv_M_l = sv_local_as<state_variables_M>();
             sv_M_g->to_start();
             sv_M_l->to_start();
             break;
         }
         case 2: {
-            auto sv_T_g = std::dynamic_pointer_cast<state_variables_T>(sptr_sv_global);
-            auto sv_T_l = std::dynamic_pointer_cast<state_variables_T>(sptr_sv_local);
+            auto sv_T_g = sv_global_as<state_variables_T>();
+            auto sv_T_l = sv_local_as<state_variables_T>();
             sv_T_g->to_start();
             sv_T_l->to_start();
             break;
@@ -234,7 +266,7 @@ void phase_characteristics::to_start()
         }
     }
     sptr_multi->to_start();
-    for(auto r : sub_phases) {
+    for(auto &r : sub_phases) {
         r.to_start();
     }
     
@@ -246,15 +278,15 @@ void phase_characteristics::set_start()
 {
     switch (sv_type) {
         case 1: {
-            auto sv_M_g = std::dynamic_pointer_cast<state_variables_M>(sptr_sv_global);
-            auto sv_M_l = std::dynamic_pointer_cast<state_variables_M>(sptr_sv_local);
+            auto sv_M_g = sv_global_as<state_variables_M>();
+            auto sv_M_l = sv_local_as<state_variables_M>();
             sv_M_g->set_start();
             sv_M_l->set_start();
             break;
         }
         case 2: {
-            auto sv_T_g = std::dynamic_pointer_cast<state_variables_T>(sptr_sv_global);
-            auto sv_T_l = std::dynamic_pointer_cast<state_variables_T>(sptr_sv_local);
+            auto sv_T_g = sv_global_as<state_variables_T>();
+            auto sv_T_l = sv_local_as<state_variables_T>();
             sv_T_g->set_start();
             sv_T_l->set_start();
             break;
@@ -266,7 +298,7 @@ void phase_characteristics::set_start()
         }
     }
     sptr_multi->set_start();
-    for(auto r : sub_phases) {
+    for(auto &r : sub_phases) {
         r.set_start();
     }
 }
@@ -278,15 +310,15 @@ void phase_characteristics::local2global()
     //Switch case for the state_variables type of the phase
     switch (sv_type) {
         case 1: {
-            auto sv_M_g = std::dynamic_pointer_cast<state_variables_M>(sptr_sv_global);
-            auto sv_M_l = std::dynamic_pointer_cast<state_variables_M>(sptr_sv_local);
-            sv_M_g->rotate_l2g(*sv_M_l, sptr_matprops->psi_mat, sptr_matprops->theta_mat, sptr_matprops->phi_mat);
+            auto sv_M_g = sv_global_as<state_variables_M>();
+            auto sv_M_l = sv_local_as<state_variables_M>();
+            sv_M_g->rotate_l2g(*sv_M_l, sptr_matprops->update_rotation());
             break;
         }
         case 2: {
-            auto sv_T_g = std::dynamic_pointer_cast<state_variables_T>(sptr_sv_global);
-            auto sv_T_l = std::dynamic_pointer_cast<state_variables_T>(sptr_sv_local);
-            sv_T_g->rotate_l2g(*sv_T_l, sptr_matprops->psi_mat, sptr_matprops->theta_mat, sptr_matprops->phi_mat);
+            auto sv_T_g = sv_global_as<state_variables_T>();
+            auto sv_T_l = sv_local_as<state_variables_T>();
+            sv_T_g->rotate_l2g(*sv_T_l, sptr_matprops->update_rotation());
             break;
         }
         default: {
@@ -305,15 +337,15 @@ void phase_characteristics::global2local()
     //Switch case for the state_variables type of the phase
     switch (sv_type) {
         case 1: {
-            auto sv_M_g = std::dynamic_pointer_cast<state_variables_M>(sptr_sv_global);
-            auto sv_M_l = std::dynamic_pointer_cast<state_variables_M>(sptr_sv_local);
-            sv_M_l->rotate_g2l(*sv_M_g, sptr_matprops->psi_mat, sptr_matprops->theta_mat, sptr_matprops->phi_mat);
+            auto sv_M_g = sv_global_as<state_variables_M>();
+            auto sv_M_l = sv_local_as<state_variables_M>();
+            sv_M_l->rotate_g2l(*sv_M_g, sptr_matprops->update_rotation());
             break;
         }
         case 2: {
-            auto sv_T_g = std::dynamic_pointer_cast<state_variables_T>(sptr_sv_global);
-            auto sv_T_l = std::dynamic_pointer_cast<state_variables_T>(sptr_sv_local);
-            sv_T_l->rotate_g2l(*sv_T_g, sptr_matprops->psi_mat, sptr_matprops->theta_mat, sptr_matprops->phi_mat);
+            auto sv_T_g = sv_global_as<state_variables_T>();
+            auto sv_T_l = sv_local_as<state_variables_T>();
+            sv_T_l->rotate_g2l(*sv_T_g, sptr_matprops->update_rotation());
             break;
         }
         default: {
@@ -336,6 +368,7 @@ phase_characteristics& phase_characteristics::operator = (const phase_characteri
     sptr_sv_local = pc.sptr_sv_local;
     sptr_out_global = pc.sptr_out_global;
     sptr_out_local = pc.sptr_out_local;
+    sptr_writer = pc.sptr_writer;
     
     sub_phases = pc.sub_phases;
     sub_phases_file = pc.sub_phases_file;
@@ -344,7 +377,7 @@ phase_characteristics& phase_characteristics::operator = (const phase_characteri
 }
 
 //----------------------------------------------------------------------
-void phase_characteristics::define_output(const std::string &path, const std::string &outputfile, const std::string &coordsys)
+void phase_characteristics::define_output(const std::string &path, const std::string &outputfile, const std::string &coordsys, const solver_output &so, const std::shared_ptr<output_writer> &writer)
 //----------------------------------------------------------------------
 {
 
@@ -357,15 +390,28 @@ void phase_characteristics::define_output(const std::string &path, const std::st
 //        filename = filename + ext_filename;
     
 //    std::ofstream of_file(filename);
+    sptr_writer = writer;
+    ios::openmode mode = (so.o_format == 1) ? (ios::out | ios::trunc | ios::binary) : (ios::out | ios::trunc);
     if(coordsys == "global") {
-        sptr_out_global = make_shared<ofstream>(path_filename);
+        sptr_out_global = make_shared<ofstream>(path_filename, mode);
     }
     else if(coordsys == "local") {
-        sptr_out_local = make_shared<ofstream>(path_filename);
+        sptr_out_local = make_shared<ofstream>(path_filename, mode);
     }
     
     for(unsigned int i=0; i<sub_phases.size(); i++) {
-        sub_phases[i].define_output(path, filename, coordsys);
+        sub_phases[i].define_output(path, filename, coordsys, so, writer);
+    }
+    
+    //The header of the binary result files is written before any record
+    if (so.o_format == 1) {
+        vec values;
+        std::vector<std::string> names;
+        output_columns(so, 0., coordsys, values, &names);
+        if(coordsys == "global")
+            write_binary_header(*sptr_out_global, names);
+        else if(coordsys == "local")
+            write_binary_header(*sptr_out_local, names);
     }
     
 }
@@ -375,6 +421,23 @@ void phase_characteristics::output(const solver_output &so, const int &kblock, c
 //----------------------------------------------------------------------
 {
 
+    //Binary records (no formatting of the values) or records passed to the writer thread
+    if ((so.o_format == 1)||(sptr_writer)) {
+        std::shared_ptr<std::ofstream> sptr_out = (coordsys == "global") ? sptr_out_global : sptr_out_local;
+        vec values;
+        int first_statev = output_columns(so, Time, coordsys, values);
+        
+        if (sptr_writer)
+            sptr_writer->push(sptr_out, so.o_format, kblock+1, kcycle+1, kstep+1, kinc+1, values, first_statev);
+        else
+            write_binary_record(*sptr_out, kblock+1, kcycle+1, kstep+1, kinc+1, values);
+        
+        for(auto &r : sub_phases) {
+            r.output(so, kblock, kcycle, kstep, kinc, Time, coordsys);
+        }
+        return;
+    }
+    
     if(coordsys == "global") {
         *sptr_out_global << kblock+1 << "\t";
         *sptr_out_global << kcycle+1 << "\t";
@@ -394,7 +457,7 @@ void phase_characteristics::output(const solver_output &so, const int &kblock, c
                 }
                 case 2: {
                     //We need to cast sv
-                    std::shared_ptr<state_variables_T> sv_T = std::dynamic_pointer_cast<state_variables_T>(sptr_sv_global);
+                    state_variables_T *sv_T = sv_global_as<state_variables_T>();
                     *sptr_out_global << sv_T->T  << "\t";
                     *sptr_out_global << sv_T->Q << "\t";                //This is for the flux
                     *sptr_out_global << sv_T->r << "\t";                //This is for the r
@@ -420,7 +483,7 @@ void phase_characteristics::output(const solver_output &so, const int &kblock, c
 
         switch (sv_type) {
             case 1: {
-                std::shared_ptr<state_variables_M> sv_M = std::dynamic_pointer_cast<state_variables_M>(sptr_sv_global);
+                state_variables_M *sv_M = sv_global_as<state_variables_M>();
                 *sptr_out_global << sv_M->Wm(0)  << "\t";
                 *sptr_out_global << sv_M->Wm(1)  << "\t";
                 *sptr_out_global << sv_M->Wm(2)  << "\t";
@@ -429,7 +492,7 @@ void phase_characteristics::output(const solver_output &so, const int &kblock, c
             }
             case 2: {
                 //We need to cast sv
-                std::shared_ptr<state_variables_T> sv_T = std::dynamic_pointer_cast<state_variables_T>(sptr_sv_global);
+                state_variables_T *sv_T = sv_global_as<state_variables_T>();
                 *sptr_out_global << sv_T->Wm(0)  << "\t";
                 *sptr_out_global << sv_T->Wm(1)  << "\t";
                 *sptr_out_global << sv_T->Wm(2)  << "\t";
@@ -462,7 +525,7 @@ void phase_characteristics::output(const solver_output &so, const int &kblock, c
         }
         *sptr_out_global << endl;
         
-        for(auto r : sub_phases) {
+        for(auto &r : sub_phases) {
             r.output(so, kblock, kcycle, kstep, kinc, Time, "global");
         }
     }
@@ -486,7 +549,7 @@ void phase_characteristics::output(const solver_output &so, const int &kblock, c
                     }
                     case 2: {
                         //We need to cast sv
-                        std::shared_ptr<state_variables_T> sv_T = std::dynamic_pointer_cast<state_variables_T>(sptr_sv_local);
+                        state_variables_T *sv_T = sv_local_as<state_variables_T>();
                         *sptr_out_local << sv_T->T  << "\t";
                         *sptr_out_local << sv_T->Q << "\t";                //This is for the flux
                         *sptr_out_local << sv_T->r << "\t";                //This is for the r
@@ -512,7 +575,7 @@ void phase_characteristics::output(const solver_output &so, const int &kblock, c
         
         switch (sv_type) {
             case 1: {
-                std::shared_ptr<state_variables_M> sv_M = std::dynamic_pointer_cast<state_variables_M>(sptr_sv_global);
+                state_variables_M *sv_M = sv_global_as<state_variables_M>();
                 *sptr_out_local << sv_M->Wm(0)  << "\t";
                 *sptr_out_local << sv_M->Wm(1)  << "\t";
                 *sptr_out_local << sv_M->Wm(2)  << "\t";
@@ -521,7 +584,7 @@ void phase_characteristics::output(const solver_output &so, const int &kblock, c
             }
             case 2: {
                 //We need to cast sv
-                std::shared_ptr<state_variables_T> sv_T = std::dynamic_pointer_cast<state_variables_T>(sptr_sv_global);
+                state_variables_T *sv_T = sv_global_as<state_variables_T>();
                 *sptr_out_local << sv_T->Wm(0)  << "\t";
                 *sptr_out_local << sv_T->Wm(1)  << "\t";
                 *sptr_out_local << sv_T->Wm(2)  << "\t";
@@ -554,7 +617,7 @@ void phase_characteristics::output(const solver_output &so, const int &kblock, c
         }
         *sptr_out_local << endl;
         
-        for(auto r : sub_phases) {
+        for(auto &r : sub_phases) {
             r.output(so, kblock, kcycle, kstep, kinc, Time, "local");
         }
         
@@ -565,6 +628,111 @@ void phase_characteristics::output(const solver_output &so, const int &kblock, c
 }
     
     
+//----------------------------------------------------------------------
+int phase_characteristics::output_columns(const solver_output &so, const double &Time, const std::string &coordsys, vec &values, std::vector<std::string> *names) const
+//----------------------------------------------------------------------
+{
+    //Same columns as the ASCII result files (note that the work quantities are always the global ones)
+    state_variables *sv = (coordsys == "global") ? sptr_sv_global.get() : sptr_sv_local.get();
+    
+    int nstatev_out = 0;
+    if(so.o_nw_statev != 0){
+        if (so.o_wanted_statev(0) < 0) {
+            nstatev_out = sv->nstatev;
+        }
+        else{
+            for(int k = 0 ; k < so.o_nw_statev ; k++){
+                nstatev_out += so.o_range_statev(k) - so.o_wanted_statev(k) + 1;
+            }
+        }
+    }
+    int nwork = (sv_type == 2) ? 7 : 4;
+    values.zeros(1 + 3*int(so.o_nb_T > 0) + 2*so.o_nb_meca + nwork + nstatev_out);
+    if (names != nullptr)
+        names->resize(values.n_elem);
+    
+    int c = 0;
+    auto column = [&](const double &value, const std::string &name) {
+        values(c) = value;
+        if (names != nullptr)
+            (*names)[c] = name;
+        c++;
+    };
+    
+    column(Time, "Time");
+    
+    if (so.o_nb_T) {
+        switch (sv_type) {
+            case 1: {
+                column(sv->T, "T");
+                column(0., "Q");
+                column(0., "r");
+                break;
+            }
+            case 2: {
+                state_variables_T *sv_T = (coordsys == "global") ? sv_global_as<state_variables_T>() : sv_local_as<state_variables_T>();
+                column(sv_T->T, "T");
+                column(sv_T->Q, "Q");
+                column(sv_T->r, "r");
+                break;
+            }
+            default: {
+                cout << "error: The state_variable type does not correspond (1 for Mechanical, 2 for Thermomechanical)\n";
+                exit(0);
+                break;
+            }
+        }
+    }
+    
+    for (int z=0; z<so.o_nb_meca; z++) {
+        column(sv->Etot(so.o_meca(z)), "Etot_" + to_string(so.o_meca(z)));
+    }
+    for (int z=0; z<so.o_nb_meca; z++) {
+        column(sv->sigma(so.o_meca(z)), "sigma_" + to_string(so.o_meca(z)));
+    }
+    
+    switch (sv_type) {
+        case 1: {
+            state_variables_M *sv_M = sv_global_as<state_variables_M>();
+            for (int k=0; k<4; k++) {
+                column(sv_M->Wm(k), "Wm_" + to_string(k));
+            }
+            break;
+        }
+        case 2: {
+            state_variables_T *sv_T = sv_global_as<state_variables_T>();
+            for (int k=0; k<4; k++) {
+                column(sv_T->Wm(k), "Wm_" + to_string(k));
+            }
+            for (int k=0; k<3; k++) {
+                column(sv_T->Wt(k), "Wt_" + to_string(k));
+            }
+            break;
+        }
+        default: {
+            cout << "error: The state_variable type does not correspond (1 for Mechanical, 2 for Thermomechanical)\n";
+            exit(0);
+            break;
+        }
+    }
+    
+    int first_statev = c;
+    if(so.o_nw_statev != 0){
+        if (so.o_wanted_statev(0) < 0) {
+            for(int k = 0 ; k < sv->nstatev ; k++)
+                column(sv->statev(k), "statev_" + to_string(k));
+        }
+        else{
+            for(int k = 0 ; k < so.o_nw_statev ; k++){
+                for (int l = so.o_wanted_statev(k); l < (so.o_range_statev(k)+1); l++){
+                    column(sv->statev(l), "statev_" + to_string(l));
+                }
+            }
+        }
+    }
+    return first_statev;
+}
+    
 //--------------------------------------------------------------------------
 ostream& operator << (ostream& s, const phase_characteristics& pc)
 //--------------------------------------------------------------------------
@@ -579,7 +747,7 @@ ostream& operator << (ostream& s, const phase_characteristics& pc)
     s << "Display local state variables:\n";
     s << *pc.sptr_sv_local;
     
-    for(auto r : pc.sub_phases) {
+    for(auto &r : pc.sub_phases) {
         s << r;
     }
     
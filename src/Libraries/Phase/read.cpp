@@ -30,6 +30,7 @@
 #include <smartplus/Libraries/Geometry/cylinder.hpp>
 #include <smartplus/Libraries/Phase/material_characteristics.hpp>
 #include <smartplus/Libraries/Phase/phase_characteristics.hpp>
+#include <smartplus/Umat/umat_registry.hpp>
 
 using namespace std;
 using namespace arma;
@@ -71,7 +72,7 @@ void read_phase(phase_characteristics &rve, const string &path_data, const strin
     paramphases.open(path_inputfile, ios::in);
     paramphases >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer;
     
-    for(auto r : rve.sub_phases) {
+    for(auto &r : rve.sub_phases) {
         paramphases >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> nprops >> nstatev;
         
         r.sptr_matprops->resize(nprops);
@@ -86,9 +87,10 @@ void read_phase(phase_characteristics &rve, const string &path_data, const strin
     paramphases.open(path_inputfile, ios::in);
     paramphases >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer;
     
-    for(auto r : rve.sub_phases) {
+    for(auto &r : rve.sub_phases) {
         
         paramphases >> r.sptr_matprops->number >> r.sptr_matprops->umat_name >> r.sptr_matprops->save >>  r.sptr_shape->concentration >> r.sptr_matprops->psi_mat >> r.sptr_matprops->theta_mat >> r.sptr_matprops->phi_mat >> buffer >> buffer;
+        r.sptr_matprops->umat_id = find_umat(r.sptr_matprops->umat_name);
         
         for(int j=0; j<r.sptr_matprops->nprops; j++) {
             paramphases >> r.sptr_matprops->props(j);
@@ -138,7 +140,7 @@ void read_layer(phase_characteristics &rve, const string &path_data, const strin
     paramphases.open(path_inputfile, ios::in);
     paramphases >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer;
     
-    for(auto r : rve.sub_phases) {
+    for(auto &r : rve.sub_phases) {
         paramphases >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> nprops >> nstatev;
         
         r.sptr_matprops->resize(nprops);
@@ -153,10 +155,11 @@ void read_layer(phase_characteristics &rve, const string &path_data, const strin
     paramphases.open(path_inputfile, ios::in);
     paramphases >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer;
     
-    for(auto r : rve.sub_phases) {
+    for(auto &r : rve.sub_phases) {
         
         sptr_layer = std::dynamic_pointer_cast<layer>(r.sptr_shape);
         paramphases >> r.sptr_matprops->number >> r.sptr_matprops->umat_name >> r.sptr_matprops->save >>  r.sptr_shape->concentration >> r.sptr_matprops->psi_mat >> r.sptr_matprops->theta_mat >> r.sptr_matprops->phi_mat >> sptr_layer->psi_geom >> sptr_layer->theta_geom >> sptr_layer->phi_geom >> buffer >> buffer;
+        r.sptr_matprops->umat_id = find_umat(r.sptr_matprops->umat_name);
         
         for(int j=0; j<r.sptr_matprops->nprops; j++) {
             paramphases >> r.sptr_matprops->props(j);
@@ -210,7 +213,7 @@ void read_ellipsoid(phase_characteristics &rve, const string &path_data, const s
     paramphases.open(path_inputfile, ios::in);
     paramphases >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer;
     
-    for(auto r : rve.sub_phases) {
+    for(auto &r : rve.sub_phases) {
         paramphases >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> nprops >> nstatev;
         
         r.sptr_matprops->resize(nprops);
@@ -225,10 +228,11 @@ void read_ellipsoid(phase_characteristics &rve, const string &path_data, const s
     paramphases.open(path_inputfile, ios::in);
     paramphases >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer;
     
-    for(auto r : rve.sub_phases) {
+    for(auto &r : rve.sub_phases) {
         
         sptr_ellipsoid = std::dynamic_pointer_cast<ellipsoid>(r.sptr_shape);
         paramphases >> r.sptr_matprops->number >> sptr_ellipsoid->coatingof >> r.sptr_matprops->umat_name >> r.sptr_matprops->save >>  sptr_ellipsoid->concentration >> r.sptr_matprops->psi_mat >> r.sptr_matprops->theta_mat >> r.sptr_matprops->phi_mat >> sptr_ellipsoid->a1 >> sptr_ellipsoid->a2 >>sptr_ellipsoid->a3 >> sptr_ellipsoid->psi_geom >> sptr_ellipsoid->theta_geom >> sptr_ellipsoid->phi_geom >> buffer >> buffer;
+        r.sptr_matprops->umat_id = find_umat(r.sptr_matprops->umat_name);
         
         for(int j=0; j<r.sptr_matprops->nprops; j++) {
             paramphases >> r.sptr_matprops->props(j);
@@ -291,7 +295,7 @@ void read_cylinder(phase_characteristics &rve, const string &path_data, const st
     paramphases.open(path_inputfile, ios::in);
     paramphases >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer  >> buffer >> buffer;
     
-    for(auto r : rve.sub_phases) {
+    for(auto &r : rve.sub_phases) {
         paramphases >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> nprops >> nstatev;
         
         r.sptr_matprops->resize(nprops);
@@ -307,11 +311,12 @@ void read_cylinder(phase_characteristics &rve, const string &path_data, const st
     paramphases >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer;
     
     std::shared_ptr<material_characteristics> sptr_matprops1;
-    for(auto r : rve.sub_phases) {
+    for(auto &r : rve.sub_phases) {
         
         sptr_cylinder = std::dynamic_pointer_cast<cylinder>(r.sptr_shape);
         
         paramphases >> r.sptr_matprops->number >> sptr_cylinder->coatingof >> r.sptr_matprops->umat_name >> r.sptr_matprops->save >>  sptr_cylinder->concentration >> r.sptr_matprops->psi_mat >> r.sptr_matprops->theta_mat >> r.sptr_matprops->phi_mat >> sptr_cylinder->L >> sptr_cylinder->R >> sptr_cylinder->psi_geom >> sptr_cylinder->theta_geom >> sptr_cylinder->phi_geom >> buffer >> buffer;
+        r.sptr_matprops->umat_id = find_umat(r.sptr_matprops->umat_name);
         
         for(int j=0; j<r.sptr_matprops->nprops; j++) {
             paramphases >> r.sptr_matprops->props(j);
@@ -41,7 +41,7 @@ namespace smart{
 */
 
 //-------------------------------------------------------------
-state_variables::state_variables() : Etot(6), DEtot(6), sigma(6), sigma_start(6)
+state_variables::state_variables()
 //-------------------------------------------------------------
 {
 
@@ -61,7 +61,7 @@ state_variables::state_variables() : Etot(6), DEtot(6), sigma(6), sigma_start(6)
 */
 
 //-------------------------------------------------------------
-state_variables::state_variables(const int &m, const bool &init, const double &value) : Etot(6), DEtot(6), sigma(6), sigma_start(6)
+state_variables::state_variables(const int &m, const bool &init, const double &value)
 //-------------------------------------------------------------
 {
     
@@ -87,7 +87,7 @@ state_variables::state_variables(const int &m, const bool &init, const double &v
 }
     
 //-------------------------------------------------------------
-state_variables::state_variables(const vec &mEtot, const vec &mDEtot, const vec &msigma, const vec &msigma_start, const double &mT, const double &mDT, const int &mnstatev, const vec &mstatev, const vec &mstatev_start) : Etot(6), DEtot(6), sigma(6), sigma_start(6)
+state_variables::state_variables(const vec &mEtot, const vec &mDEtot, const vec &msigma, const vec &msigma_start, const double &mT, const double &mDT, const int &mnstatev, const vec &mstatev, const vec &mstatev_start)
 //-------------------------------------------------------------
 {	
 	assert (mEtot.size() == 6);
@@ -112,7 +112,7 @@ state_variables::state_variables(const vec &mEtot, const vec &mDEtot, const vec
 */
 
 //------------------------------------------------------
-state_variables::state_variables(const state_variables& sv) : Etot(6), DEtot(6), sigma(6), sigma_start(6)
+state_variables::state_variables(const state_variables& sv)
 //------------------------------------------------------
 {
 	Etot = sv.Etot;
@@ -306,6 +306,60 @@ state_variables& state_variables::rotate_g2l(const state_variables& sv, const do
 	return *this;
 }
 
+//----------------------------------------------------------------------
+state_variables& state_variables::rotate_l2g(const state_variables& sv, const rotation_operators &rot)
+//----------------------------------------------------------------------
+{
+    T = sv.T;
+    DT = sv.DT;
+    
+    nstatev = sv.nstatev;
+    statev = sv.statev;
+    statev_start = sv.statev_start;
+    
+    if(rot.identity) {
+        Etot = sv.Etot;
+        DEtot = sv.DEtot;
+        sigma = sv.sigma;
+        sigma_start = sv.sigma_start;
+    }
+    else {
+        Etot = rot.QE_l2g*sv.Etot;
+        DEtot = rot.QE_l2g*sv.DEtot;
+        sigma = rot.QS_l2g*sv.sigma;
+        sigma_start = rot.QS_l2g*sv.sigma_start;
+    }
+    
+    return *this;
+}
+
+//----------------------------------------------------------------------
+state_variables& state_variables::rotate_g2l(const state_variables& sv, const rotation_operators &rot)
+//----------------------------------------------------------------------
+{
+    T = sv.T;
+    DT = sv.DT;
+    
+    nstatev = sv.nstatev;
+    statev = sv.statev;
+    statev_start = sv.statev_start;
+    
+    if(rot.identity) {
+        Etot = sv.Etot;
+        DEtot = sv.DEtot;
+        sigma = sv.sigma;
+        sigma_start = sv.sigma_start;
+    }
+    else {
+        Etot = rot.QE_g2l*sv.Etot;
+        DEtot = rot.QE_g2l*sv.DEtot;
+        sigma = rot.QS_g2l*sv.sigma;
+        sigma_start = rot.QS_g2l*sv.sigma_start;
+    }
+    
+    return *this;
+}
+
 //--------------------------------------------------------------------------
 ostream& operator << (ostream& s, const state_variables& sv)
 //--------------------------------------------------------------------------
@@ -42,7 +42,7 @@ namespace smart{
 */
 
 //-------------------------------------------------------------
-state_variables_M::state_variables_M() : state_variables(), Wm(4), Wm_start(4), L(6,6), Lt(6,6)
+state_variables_M::state_variables_M() : state_variables()
 //-------------------------------------------------------------
 {
     Wm = zeros(4);
@@ -59,7 +59,7 @@ state_variables_M::state_variables_M() : state_variables(), Wm(4), Wm_start(4),
 */
 
 //-------------------------------------------------------------
-state_variables_M::state_variables_M(const vec &mEtot, const vec &mDEtot, const vec &msigma, const vec &msigma_start, const double &mT, const double &mDT, const vec &mWm, const vec& mWm_start, const int &mnstatev, const vec &mstatev, const vec &mstatev_start, const mat &mL, const mat &mLt) : state_variables(mEtot, mDEtot, msigma, msigma_start, mT, mDT, mnstatev, mstatev, mstatev_start), L(6,6), Lt(6,6)
+state_variables_M::state_variables_M(const vec &mEtot, const vec &mDEtot, const vec &msigma, const vec &msigma_start, const double &mT, const double &mDT, const vec &mWm, const vec& mWm_start, const int &mnstatev, const vec &mstatev, const vec &mstatev_start, const mat &mL, const mat &mLt) : state_variables(mEtot, mDEtot, msigma, msigma_start, mT, mDT, mnstatev, mstatev, mstatev_start)
 //-------------------------------------------------------------
 {
 
@@ -84,7 +84,7 @@ state_variables_M::state_variables_M(const vec &mEtot, const vec &mDEtot, const
 */
 
 //------------------------------------------------------
-state_variables_M::state_variables_M(const state_variables_M& sv) : state_variables(sv), Wm(4), Wm_start(4), L(6,6), Lt(6,6)
+state_variables_M::state_variables_M(const state_variables_M& sv) : state_variables(sv)
 //------------------------------------------------------
 {
     Wm = sv.Wm;
@@ -225,6 +225,54 @@ state_variables_M& state_variables_M::rotate_g2l(const state_variables_M& sv, co
 	return *this;
 }
 
+//----------------------------------------------------------------------
+state_variables_M& state_variables_M::rotate_l2g(const state_variables_M& sv, const rotation_operators &rot)
+//----------------------------------------------------------------------
+{
+    state_variables::rotate_l2g(sv, rot);
+    
+    Wm = sv.Wm;
+    Wm_start = sv.Wm_start;
+    
+    if(rot.identity) {
+        L = sv.L;
+        Lt = sv.Lt;
+    }
+    else {
+        mat66 temp;
+        temp = sv.L*trans(rot.QS_l2g);
+        L = rot.QS_l2g*temp;
+        temp = sv.Lt*trans(rot.QS_l2g);
+        Lt = rot.QS_l2g*temp;
+    }
+    
+    return *this;
+}
+
+//----------------------------------------------------------------------
+state_variables_M& state_variables_M::rotate_g2l(const state_variables_M& sv, const rotation_operators &rot)
+//----------------------------------------------------------------------
+{
+    state_variables::rotate_g2l(sv, rot);
+    
+    Wm = sv.Wm;
+    Wm_start = sv.Wm_start;
+    
+    if(rot.identity) {
+        L = sv.L;
+        Lt = sv.Lt;
+    }
+    else {
+        mat66 temp;
+        temp = sv.L*trans(rot.QS_g2l);
+        L = rot.QS_g2l*temp;
+        temp = sv.Lt*trans(rot.QS_g2l);
+        Lt = rot.QS_g2l*temp;
+    }
+    
+    return *this;
+}
+
 //--------------------------------------------------------------------------
 ostream& operator << (ostream& s, const state_variables_M& sv)
 //--------------------------------------------------------------------------
@@ -42,7 +42,7 @@ namespace smart{
 */
 
 //-------------------------------------------------------------
-state_variables_T::state_variables_T() : state_variables(), Wm(4), Wt(3), Wm_start(4), Wt_start(3), dSdE(6,6), dSdEt(6,6), dSdT(1,6), drdE(1,6), drdT(1,1)
+state_variables_T::state_variables_T() : state_variables(), dSdT(1,6), drdE(1,6), drdT(1,1)
 //-------------------------------------------------------------
 {
     Q = 0.;
@@ -63,7 +63,7 @@ state_variables_T::state_variables_T() : state_variables(), Wm(4), Wt(3), Wm_sta
 */
 
 //-------------------------------------------------------------
-state_variables_T::state_variables_T(const vec &mEtot, const vec &mDEtot, const vec &msigma, const vec &msigma_start, const double &mT, const double &mDT, const int &mnstatev, const vec &mstatev, const vec &mstatev_start, const double &mQ, const double &mr, const vec &mWm, const vec &mWt, const vec &mWm_start, const vec &mWt_start, const mat &mdSdE, const mat &mdSdEt, const mat &mdSdT, const mat &mdrdE, const mat &mdrdT) : state_variables(mEtot, mDEtot, msigma, msigma_start, mT, mDT, mnstatev, mstatev, mstatev_start), Wm(4), Wt(3), Wm_start(4), Wt_start(3), dSdE(6,6), dSdEt(6,6), dSdT(1,6), drdE(1,6), drdT(1,1)
+state_variables_T::state_variables_T(const vec &mEtot, const vec &mDEtot, const vec &msigma, const vec &msigma_start, const double &mT, const double &mDT, const int &mnstatev, const vec &mstatev, const vec &mstatev_start, const double &mQ, const double &mr, const vec &mWm, const vec &mWt, const vec &mWm_start, const vec &mWt_start, const mat &mdSdE, const mat &mdSdEt, const mat &mdSdT, const mat &mdrdE, const mat &mdrdT) : state_variables(mEtot, mDEtot, msigma, msigma_start, mT, mDT, mnstatev, mstatev, mstatev_start), dSdT(1,6), drdE(1,6), drdT(1,1)
 //-------------------------------------------------------------
 {	
 
@@ -107,7 +107,7 @@ state_variables_T::state_variables_T(const vec &mEtot, const vec &mDEtot, const
 */
 
 //------------------------------------------------------
-state_variables_T::state_variables_T(const state_variables_T& sv) : state_variables(sv), Wm(4), Wt(3), Wm_start(4), Wt_start(3), dSdE(6,6), dSdEt(6,6), dSdT(1,6), drdE(1,6), drdT(1,1)
+state_variables_T::state_variables_T(const state_variables_T& sv) : state_variables(sv), dSdT(1,6), drdE(1,6), drdT(1,1)
 //------------------------------------------------------
 {
     Q = sv.Q;
@@ -307,6 +307,74 @@ state_variables_T& state_variables_T::rotate_g2l(const state_variables_T& sv, co
 	return *this;
 }
 
+//----------------------------------------------------------------------
+state_variables_T& state_variables_T::rotate_l2g(const state_variables_T& sv, const rotation_operators &rot)
+//----------------------------------------------------------------------
+{
+    state_variables::rotate_l2g(sv, rot);
+    
+    Q = sv.Q;
+    r = sv.r;
+    Wm = sv.Wm;
+    Wt = sv.Wt;
+    Wm_start = sv.Wm_start;
+    Wt_start = sv.Wt_start;
+    drdT = sv.drdT;
+    
+    if(rot.identity) {
+        dSdE = sv.dSdE;
+        dSdEt = sv.dSdEt;
+        dSdT = sv.dSdT;
+        drdE = sv.drdE;
+    }
+    else {
+        mat66 temp;
+        temp = sv.dSdE*trans(rot.QS_l2g);
+        dSdE = rot.QS_l2g*temp;
+        temp = sv.dSdEt*trans(rot.QS_l2g);
+        dSdEt = rot.QS_l2g*temp;
+        //dSdT and drdE are stored as (1,6) rows
+        dSdT = sv.dSdT*trans(rot.QS_l2g);
+        drdE = sv.drdE*trans(rot.QE_l2g);
+    }
+    
+    return *this;
+}
+
+//----------------------------------------------------------------------
+state_variables_T& state_variables_T::rotate_g2l(const state_variables_T& sv, const rotation_operators &rot)
+//----------------------------------------------------------------------
+{
+    state_variables::rotate_g2l(sv, rot);
+    
+    Q = sv.Q;
+    r = sv.r;
+    Wm = sv.Wm;
+    Wt = sv.Wt;
+    Wm_start = sv.Wm_start;
+    Wt_start = sv.Wt_start;
+    drdT = sv.drdT;
+    
+    if(rot.identity) {
+        dSdE = sv.dSdE;
+        dSdEt = sv.dSdEt;
+        dSdT = sv.dSdT;
+        drdE = sv.drdE;
+    }
+    else {
+        mat66 temp;
+        temp = sv.dSdE*trans(rot.QS_g2l);
+        dSdE = rot.QS_g2l*temp;
+        temp = sv.dSdEt*trans(rot.QS_g2l);
+        dSdEt = rot.QS_g2l*temp;
+        //dSdT and drdE are stored as (1,6) rows
+        dSdT = sv.dSdT*trans(rot.QS_g2l);
+        drdE = sv.drdE*trans(rot.QE_g2l);
+    }
+    
+    return *this;
+}
+
 //--------------------------------------------------------------------------
 ostream& operator << (ostream& s, const state_variables_T& sv)
 //--------------------------------------------------------------------------
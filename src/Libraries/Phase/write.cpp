@@ -46,7 +46,7 @@ void write_phase(phase_characteristics &rve, const string &path_data, const stri
     
     paramphases << "Number\t" << "umat\t" << "save\t" << "c\t" << "psi_mat\t" << "theta_mat\t" << "phi_mat\t" << "nprops\t" << "nstatev\t" << "props\n";
     
-    for(auto r : rve.sub_phases) {
+    for(auto &r : rve.sub_phases) {
         
         r.sptr_matprops->psi_mat*=(180./pi);
         r.sptr_matprops->theta_mat*=(180./pi);
@@ -72,7 +72,7 @@ void write_layer(phase_characteristics &rve, const string &path_data, const stri
     
     paramphases << "Number\t" << "umat\t" << "save\t" << "c\t" << "psi_mat\t" << "theta_mat\t" << "phi_mat\t" << "psi_geom\t" << "theta_geom\t"	<< "phi_geom\t" << "nprops\t" << "nstatev\t" << "props\n";
     
-    for(auto r : rve.sub_phases) {
+    for(auto &r : rve.sub_phases) {
 
         r.sptr_matprops->psi_mat*=(180./pi);
         r.sptr_matprops->theta_mat*=(180./pi);
@@ -103,7 +103,7 @@ void write_ellipsoid(phase_characteristics &rve, const string &path_data, const
     
     paramphases << "Number\t" << "Coatingof\t" << "umat\t" << "save\t" << "c\t" << "psi_mat\t" << "theta_mat\t" << "phi_mat\t" << "a1\t" << "a2\t" << "a3\t" << "psi_geom\t" << "theta_geom\t"	<< "phi_geom\t" << "nprops\t" << "nstatev\t" << "props\n";
     
-    for(auto r : rve.sub_phases) {
+    for(auto &r : rve.sub_phases) {
         
         r.sptr_matprops->psi_mat*=(180./pi);
         r.sptr_matprops->theta_mat*=(180./pi);
@@ -134,7 +134,7 @@ void write_cylinder(phase_characteristics &rve, const string &path_data, const s
     
     paramphases << "Number\t" << "Coatingof\t" << "umat\t" << "save\t" << "c\t" << "psi_mat\t" << "theta_mat\t" << "phi_mat\t" << "L\t" << "R\t" << "psi_geom\t" << "theta_geom\t"	<< "phi_geom\t" << "nprops\t" << "nstatev\t" << "props\n";
     
-    for(auto r : rve.sub_phases) {
+    for(auto &r : rve.sub_phases) {
         
         r.sptr_matprops->psi_mat*=(180./pi);
         r.sptr_matprops->theta_mat*=(180./pi);
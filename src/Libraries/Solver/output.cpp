@@ -22,6 +22,8 @@
 #include <iostream>
 #include <sstream>
 #include <fstream>
+#include <cstring>
+#include <cstdint>
 #include <assert.h>
 #include <math.h>
 #include <armadillo>
@@ -44,6 +46,7 @@ solver_output::solver_output()
     o_nb_meca = 0;
     o_nb_T = 0;
     o_nw_statev = 0;
+    o_format = 0;
 }
 
 /*!
@@ -58,6 +61,7 @@ solver_output::solver_output(const int &nblock)
     o_nb_meca = 0;
     o_nb_T = 0;
     o_nw_statev = 0;
+    o_format = 0;
     
     o_type.zeros(nblock);
     o_nfreq.zeros(nblock);
@@ -83,6 +87,7 @@ solver_output::solver_output(const solver_output& so)
     o_type = so.o_type;
     o_nfreq = so.o_nfreq;
     o_tfreq = so.o_tfreq;
+    o_format = so.o_format;
 }
 
 /*!
@@ -109,6 +114,7 @@ solver_output& solver_output::operator = (const solver_output& so)
     o_type = so.o_type;
     o_nfreq = so.o_nfreq;
     o_tfreq = so.o_tfreq;
+    o_format = so.o_format;
     
 	return *this;
 }
@@ -138,8 +144,183 @@ ostream& operator << (ostream& s, const solver_output& so)
         s << "\n\n";
         
     }
+    s << "format: " << ((so.o_format == 1) ? "binary" : "ascii") << "\n";
     
 	return s;
 }
+    
+//@brief default constructor
+//-------------------------------------------------------------
+solver_results::solver_results()
+//-------------------------------------------------------------
+{
+    ncols = 0;
+}
+
+//-------------------------------------------------------------
+void solver_results::clear()
+//-------------------------------------------------------------
+{
+    ncols = 0;
+    data.clear();
+}
+
+//-------------------------------------------------------------
+void solver_results::push(const int &kblock, const int &kcycle, const int &kstep, const int &kinc, const vec &values)
+//-------------------------------------------------------------
+{
+    if (ncols == 0)
+        ncols = 4 + values.n_elem;
+    assert(ncols == int(4 + values.n_elem));
+    
+    data.push_back(kblock);
+    data.push_back(kcycle);
+    data.push_back(kstep);
+    data.push_back(kinc);
+    data.insert(data.end(), values.begin(), values.end());
+}
+
+//-------------------------------------------------------------
+unsigned int solver_results::size() const
+//-------------------------------------------------------------
+{
+    return (ncols > 0) ? data.size()/ncols : 0;
+}
+
+//-------------------------------------------------------------
+mat solver_results::records() const
+//-------------------------------------------------------------
+{
+    if (ncols == 0)
+        return mat();
+    
+    //The records are contiguous, so they are the columns of the transposed matrix
+    mat records_t(data.data(), ncols, size());
+    return records_t.t();
+}
+
+//-------------------------------------------------------------
+void write_binary_header(ostream &s, const std::vector<string> &names)
+//-------------------------------------------------------------
+{
+    const char magic[8] = {'S','M','A','R','T','O','U','T'};
+    int32_t version = 1;
+    int32_t ncols = names.size();
+    
+    s.write(magic, 8);
+    s.write(reinterpret_cast<const char*>(&version), sizeof(int32_t));
+    s.write(reinterpret_cast<const char*>(&ncols), sizeof(int32_t));
+    
+    char name[16];
+    for (auto &n : names) {
+        memset(name, 0, 16);
+        strncpy(name, n.c_str(), 15);
+        s.write(name, 16);
+    }
+}
+    
+//-------------------------------------------------------------
+void write_binary_record(ostream &s, const int &kblock, const int &kcycle, const int &kstep, const int &kinc, const vec &values)
+//-------------------------------------------------------------
+{
+    int32_t ids[4] = {kblock, kcycle, kstep, kinc};
+    s.write(reinterpret_cast<const char*>(ids), 4*sizeof(int32_t));
+    s.write(reinterpret_cast<const char*>(values.memptr()), values.n_elem*sizeof(double));
+}
+    
+//-------------------------------------------------------------
+void write_ascii_record(ostream &s, const int &kblock, const int &kcycle, const int &kstep, const int &kinc, const vec &values, const int &first_statev)
+//-------------------------------------------------------------
+{
+    s << kblock << "\t";
+    s << kcycle << "\t";
+    s << kstep << "\t";
+    s << kinc << "\t";
+    
+    //The time is followed by an empty column, as are the work quantities
+    int ncols = values.n_elem;
+    for (int c=0; c<ncols; c++) {
+        if (c == first_statev)
+            s << "\t";
+        s << values(c) << "\t";
+        if (c == 0)
+            s << "\t";
+    }
+    if (first_statev >= ncols)
+        s << "\t";
+    s << "\n";
+}
+    
+//-------------------------------------------------------------
+void read_binary_output(const string &path_filename, std::vector<string> &names, Mat<int> &ids, mat &values)
+//-------------------------------------------------------------
+{
+    ifstream s(path_filename, ios::in | ios::binary);
+    if (!s) {
+        cout << "Error: cannot open the file " << path_filename << "\n";
+        return;
+    }
+    
+    char magic[8];
+    int32_t version = 0;
+    int32_t ncols = 0;
+    s.read(magic, 8);
+    s.read(reinterpret_cast<char*>(&version), sizeof(int32_t));
+    s.read(reinterpret_cast<char*>(&ncols), sizeof(int32_t));
+    if ((!s)||(string(magic, 8) != "SMARTOUT")||(version != 1)) {
+        cout << "Error: the file " << path_filename << " is not a binary result file\n";
+        return;
+    }
+    
+    names.resize(ncols);
+    char name[16];
+    for (int i=0; i<ncols; i++) {
+        s.read(name, 16);
+        names[i] = string(name, strnlen(name, 16));
+    }
+    
+    //The number of records is given by the size of the file
+    streampos start = s.tellg();
+    s.seekg(0, ios::end);
+    streamoff nbytes = s.tellg() - start;
+    s.seekg(start);
+    
+    streamoff record_size = 4*sizeof(int32_t) + ncols*sizeof(double);
+    int nrecords = int(nbytes/record_size);
+    
+    ids.zeros(nrecords, 4);
+    values.zeros(nrecords, ncols);
+    int32_t id[4];
+    vec record = zeros(ncols);
+    for (int r=0; r<nrecords; r++) {
+        s.read(reinterpret_cast<char*>(id), 4*sizeof(int32_t));
+        s.read(reinterpret_cast<char*>(record.memptr()), ncols*sizeof(double));
+        for (int k=0; k<4; k++) {
+            ids(r,k) = id[k];
+        }
+        values.row(r) = trans(record);
+    }
+}
+    
+//-------------------------------------------------------------
+void binary2ascii(const string &binfile, const string &asciifile)
+//-------------------------------------------------------------
+{
+    std::vector<string> names;
+    Mat<int> ids;
+    mat values;
+    read_binary_output(binfile, names, ids, values);
+    
+    ofstream s(asciifile);
+    for (unsigned int r=0; r<ids.n_rows; r++) {
+        for (int k=0; k<4; k++) {
+            s << ids(r,k) << "\t";
+        }
+        for (unsigned int c=0; c<values.n_cols; c++) {
+            s << values(r,c) << "\t";
+        }
+        s << "\n";
+    }
+}
 
 } //namespace smart
@@ -0,0 +1,165 @@
+/* This file is part of SMART+.
+ 
+ SMART+ is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ SMART+ is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with SMART+.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+
+///@file output_writer.cpp
+///@brief Asynchronous writer of the result files of the solver
+///@version 1.0
+
+#include <iostream>
+#include <fstream>
+#include <chrono>
+#include <algorithm>
+#include <cstdlib>
+#include <set>
+#include <mutex>
+#include <assert.h>
+#include <armadillo>
+#include <smartplus/Libraries/Solver/output.hpp>
+#include <smartplus/Libraries/Solver/output_writer.hpp>
+
+using namespace std;
+using namespace arma;
+
+namespace smart{
+
+//The writers alive are closed at the exit of the program, so that their records reach the files when the solver stops with exit(0)
+static std::mutex writers_mutex;
+
+static std::set<output_writer*>& writers_alive()
+{
+    static std::set<output_writer*> writers;
+    return writers;
+}
+
+static void close_writers()
+{
+    std::lock_guard<std::mutex> lock(writers_mutex);
+    for (auto w : writers_alive()) {
+        w->close();
+    }
+}
+
+//=====Private methods for output_writer===================================
+
+//-------------------------------------------------------------
+void output_writer::run()
+//-------------------------------------------------------------
+{
+    std::vector<std::shared_ptr<std::ofstream> > written;   //streams to flush once the queue is empty
+    
+    while (true) {
+        std::size_t h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire)) {
+            
+            for (auto &s : written) {
+                s->flush();
+            }
+            written.clear();
+            
+            if (stop.load(std::memory_order_acquire)) {
+                if (h == tail.load(std::memory_order_acquire))
+                    break;
+                continue;
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+            continue;
+        }
+        
+        output_record &r = ring[h & mask];
+        if (r.format == 1)
+            write_binary_record(*r.sptr_out, r.ids[0], r.ids[1], r.ids[2], r.ids[3], r.values);
+        else
+            write_ascii_record(*r.sptr_out, r.ids[0], r.ids[1], r.ids[2], r.ids[3], r.values, r.first_statev);
+        
+        if (find(written.begin(), written.end(), r.sptr_out) == written.end())
+            written.push_back(r.sptr_out);
+        r.sptr_out.reset();
+        
+        head.store(h+1, std::memory_order_release);
+    }
+}
+
+//=====Public methods for output_writer============================================
+
+/*!
+  \brief Constructor
+  \param capacity : number of records of the queue
+*/
+
+//-------------------------------------------------------------
+output_writer::output_writer(const int &capacity) : head(0), tail(0), stop(false)
+//-------------------------------------------------------------
+{
+    std::size_t size = 1;
+    while (size < std::size_t(max(capacity, 1))) {
+        size *= 2;
+    }
+    ring.resize(size);
+    mask = size - 1;
+    
+    worker = std::thread(&output_writer::run, this);
+    
+    std::lock_guard<std::mutex> lock(writers_mutex);
+    writers_alive().insert(this);
+    static bool at_exit = (std::atexit(close_writers) == 0);
+    (void)at_exit;
+}
+
+/*!
+  \brief destructor
+*/
+
+output_writer::~output_writer() {
+    close();
+    
+    std::lock_guard<std::mutex> lock(writers_mutex);
+    writers_alive().erase(this);
+}
+    
+//-------------------------------------------------------------
+void output_writer::push(const std::shared_ptr<std::ofstream> &sptr_out, const int &format, const int &kblock, const int &kcycle, const int &kstep, const int &kinc, const vec &values, const int &first_statev)
+//-------------------------------------------------------------
+{
+    std::size_t t = tail.load(std::memory_order_relaxed);
+    while (t - head.load(std::memory_order_acquire) >= ring.size()) {
+        std::this_thread::yield();
+    }
+    
+    //The slot is reused: the values are copied in its memory if the number of columns has not changed
+    output_record &r = ring[t & mask];
+    r.sptr_out = sptr_out;
+    r.format = format;
+    r.ids[0] = kblock;
+    r.ids[1] = kcycle;
+    r.ids[2] = kstep;
+    r.ids[3] = kinc;
+    r.values = values;
+    r.first_statev = first_statev;
+    
+    tail.store(t+1, std::memory_order_release);
+}
+    
+//-------------------------------------------------------------
+void output_writer::close()
+//-------------------------------------------------------------
+{
+    stop.store(true, std::memory_order_release);
+    if (worker.joinable())
+        worker.join();
+}
+
+} //namespace smart
@@ -26,6 +26,7 @@
 #include <smartplus/Libraries/Solver/step_meca.hpp>
 #include <smartplus/Libraries/Solver/step_thermomeca.hpp>
 #include <smartplus/Libraries/Solver/output.hpp>
+#include <smartplus/Libraries/Maths/lu_fixed.hpp>
 
 using namespace std;
 using namespace arma;
@@ -82,6 +83,44 @@ void Lth_2_K(const mat &dSdE, mat &dSdT, mat &dQdE, mat &dQdT, mat &K, const Col
     }
 }
 
+/// Same as Lt_2_K, in the stack storage of the factorization
+void Lt_2_K(const mat &Lt, LU_fixed<6> &K, const Col<int> &cBC_meca, const double &lambda)
+{
+    K.zeros();
+    
+    for (int i=0; i<6; i++) {
+        if (cBC_meca(i)) {
+            for (int j=0; j<6; j++)
+                K(i,j) = Lt(i,j);
+        }
+        else
+            K(i,i) = lambda;
+    }
+}
+
+/// Same as Lth_2_K, in the stack storage of the factorization
+void Lth_2_K(const mat &dSdE, const mat &dSdT, const mat &dQdE, const mat &dQdT, LU_fixed<7> &K, const Col<int> &cBC_meca, const int &cBC_T, const double &lambda)
+{
+    K.zeros();
+    
+    for (int i=0; i<6; i++) {
+        if (cBC_meca(i)) {
+            for (int j=0; j<6; j++)
+                K(i,j) = dSdE(i,j);
+            K(i,6) = dSdT(i,0);
+        }
+        else
+            K(i,i) = lambda;
+    }
+    if (cBC_T) {
+        for (int j=0; j<6; j++)
+            K(6,j) = dQdE(0,j);
+        K(6,6) = dQdT(0,0);
+    }
+    else
+        K(6,6) = lambda;
+}
+
 void read_matprops(string &umat_name, int &nprops, vec &props, int &nstatev, double &psi_rve, double &theta_rve, double &phi_rve, const string &path_data, const string &materialfile) {
 
     ///Material properties reading, use "material.dat" to specify parameters values
@@ -186,6 +225,13 @@ void read_output(solver_output &so, const int &nblock, const int &nstatev, const
             else
                 cyclic_output >> buffer;
         }
+        
+        //Optional format of the result files, ASCII by default
+        string format;
+        if (cyclic_output >> buffer >> format) {
+            if ((format == "binary") || (format == "Binary") || (format == "BINARY"))
+                so.o_format = 1;
+        }
         cyclic_output.close();
     }
     else {
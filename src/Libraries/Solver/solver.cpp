@@ -39,6 +39,9 @@
 #include <smartplus/Libraries/Solver/step.hpp>
 #include <smartplus/Libraries/Solver/step_meca.hpp>
 #include <smartplus/Libraries/Solver/step_thermomeca.hpp>
+#include <smartplus/Libraries/Solver/output_writer.hpp>
+#include <smartplus/Libraries/Solver/solver.hpp>
+#include <smartplus/Libraries/Maths/lu_fixed.hpp>
 
 using namespace std;
 using namespace arma;
@@ -52,29 +55,69 @@ void solver(const string &umat_name, const vec &props, const double &nstatev, co
         cout << "error: the folder for the data, " << path_data << ", is not present" << endl;
         return;
     }
-    if(!boost::filesystem::is_directory(path_results)) {
-        cout << "The folder for the results, " << path_results << ", is not present and has been created" << endl;
-        boost::filesystem::create_directory(path_results);
-    }
     
-    std::string ext_filename = outputfile.substr(outputfile.length()-4,outputfile.length());
-    std::string filename = outputfile.substr(0,outputfile.length()-4); //to remove the extension
+    std::string output_info_file = "output.dat";
+    
+    std::vector<block> blocks;  //loading blocks
+    double T_init = 0.;
     
-    std::string outputfile_global = filename + "_global" + ext_filename;
-    std::string outputfile_local = filename + "_local" + ext_filename;
+    //Read the loading path
+    read_path(blocks, T_init, path_data, pathfile);
     
-    std::string output_info_file = "output.dat";
+    //Output
+    solver_output so(blocks.size());
+    read_output(so, blocks.size(), nstatev, path_data, output_info_file);
+    
+    //Check output and step files
+    check_path_output(blocks, so);
+    
+    solver(umat_name, props, nstatev, psi_rve, theta_rve, phi_rve, blocks, T_init, so, path_results, outputfile);
+}
+    
+void solver(const string &umat_name, const vec &props, const double &nstatev, const double &psi_rve, const double &theta_rve, const double &phi_rve, std::vector<block> &blocks, const double &T_init, const solver_output &so, const std::string &path_results, const std::string &outputfile) {
+
+    phase_characteristics rve;  // Representative volume element
+    
+    ///Material properties reading, use "material.dat" to specify parameters values
+    rve.sptr_matprops->update(0, umat_name, 1, psi_rve, theta_rve, phi_rve, props.n_elem, props);
+    
+    solver(rve, nstatev, blocks, T_init, so, path_results, outputfile);
+}
+    
+void solver(phase_characteristics &rve, const double &nstatev, std::vector<block> &blocks, const double &T_init, const solver_output &so, const std::string &path_results, const std::string &outputfile, solver_results *results) {
+
+    //The records are either kept in memory, or written in the result files
+    std::string outputfile_global;
+    std::string outputfile_local;
+    if (results == nullptr) {
+        if(!boost::filesystem::is_directory(path_results)) {
+            cout << "The folder for the results, " << path_results << ", is not present and has been created" << endl;
+            boost::filesystem::create_directory(path_results);
+        }
+        
+        std::string ext_filename = outputfile.substr(outputfile.length()-4,outputfile.length());
+        std::string filename = outputfile.substr(0,outputfile.length()-4); //to remove the extension
+        
+        outputfile_global = filename + "_global" + ext_filename;
+        outputfile_local = filename + "_local" + ext_filename;
+    }
+    else {
+        results->clear();
+    }
+    vec values;
     
 	///Usefull UMAT variables
 	int ndi = 3;
-	int nshr = 3;    
-    std::vector<block> blocks;  //loading blocks
-    phase_characteristics rve;  // Representative volume element
+	int nshr = 3;
+    
+    //The records of the result files are written by a background thread if output_queue_size > 0. It is joined, and the files flushed, at any exit of the solver
+    std::shared_ptr<output_writer> writer;
+    if ((output_queue_size > 0)&&(results == nullptr))
+        writer = make_shared<output_writer>(output_queue_size);
     
 	bool start = true;
 	double Time = 0.;
 	double DTime = 0.;
-    double T_init = 0.;
     double tnew_dt = 1.;
     
 //    mat L = zeros(6,6);
@@ -86,32 +129,20 @@ void solver(const string &umat_name, const vec &props, const double &nstatev, co
     mat dQdE = zeros(6,1);
     mat dQdT = zeros(1,1);
     
-    //read the material properties
-    //Read the loading path
-    read_path(blocks, T_init, path_data, pathfile);
-    
 /*    for(auto b : blocks) {
         cout << "blocks = " << b << "\n";
     }*/
     
-    ///Material properties reading, use "material.dat" to specify parameters values
-    rve.sptr_matprops->update(0, umat_name, 1, psi_rve, theta_rve, phi_rve, props.n_elem, props);
-    
     //Output
     int o_ncount = 0;
     double o_tcount = 0.;
-    solver_output so(blocks.size());
-    read_output(so, blocks.size(), nstatev, path_data, output_info_file);
-    
-    //Check output and step files
-    check_path_output(blocks, so);
     
     double error = 0.;
     vec residual;
     vec Delta;
     int nK = 0; // The size of the problem to solve
-    mat K;
-    mat invK;
+    LU_fixed<6> K_meca;         // Jacobian of the mixed problem, factorized on stack storage
+    LU_fixed<7> K_thermomeca;
     int compteur = 0.;
     
     int inc = 0.;
@@ -129,8 +160,6 @@ void solver(const string &umat_name, const vec &props, const double &nstatev, co
                 /// resize the problem to solve
                 residual = zeros(6);
                 Delta = zeros(6);
-                K = zeros(6,6);
-                invK = zeros(6,6);
                 
                 shared_ptr<state_variables_M> sv_M;
                 
@@ -159,10 +188,10 @@ void solver(const string &umat_name, const vec &props, const double &nstatev, co
                 //Run the umat for the first time in the block. So that we get the proper tangent properties
                 run_umat_M(rve, DR, Time, DTime, ndi, nshr, start, tnew_dt);
                 
-                if(start) {
+                if((start)&&(results == nullptr)) {
                     //Use the number of phases saved to define the files
-                    rve.define_output(path_results, outputfile_global, "global");
-                    rve.define_output(path_results, outputfile_local, "local");
+                    rve.define_output(path_results, outputfile_global, "global", so, writer);
+                    rve.define_output(path_results, outputfile_local, "local", so, writer);
                     //Write the initial results
 //                    rve.output(so, -1, -1, -1, -1, Time, "global");
 //                    rve.output(so, -1, -1, -1, -1, Time, "local");
@@ -228,13 +257,20 @@ void solver(const string &umat_name, const vec &props, const double &nstatev, co
                                         
                                         ///Prediction of the strain increment using the tangent modulus given from the umat_ function
                                         //we use the ddsdde (Lt) from the previous increment
-                                        Lt_2_K(sv_M->Lt, K, sptr_meca->cBC_meca, lambda_solver);
-                                        
-                                        ///jacobian inversion
-                                        invK = inv(K);
+                                        //With the modified Newton method, the factorization of the first iteration is kept until the end of the increment
+                                        if ((modified_newton_solver == 0)||(compteur == 0)) {
+                                            Lt_2_K(sv_M->Lt, K_meca, sptr_meca->cBC_meca, lambda_solver);
+                                            
+                                            ///jacobian factorization
+                                            if (!K_meca.factorize()) {
+                                                cout << "error : The jacobian of the mixed problem is singular\n";
+                                                return;
+                                            }
+                                        }
                                         
                                         /// Prediction of the component of the strain tensor
-                                        Delta = -invK * residual;
+                                        K_meca.solve(residual, Delta);
+                                        Delta *= -1.;
                                         
                                         sv_M->DEtot += Delta;
                                         sv_M->DT = Dtinc*sptr_meca->Ts(inc);
@@ -325,8 +361,14 @@ void solver(const string &umat_name, const vec &props, const double &nstatev, co
                             //Write the results
                             if (((so.o_type(i) == 1)&&(o_ncount == so.o_nfreq(i)))||(((so.o_type(i) == 2)&&(fabs(o_tcount - so.o_tfreq(i)) < 1.E-12)))) {
                                 
-                                rve.output(so, i, n, j, inc, Time, "global");
-                                rve.output(so, i, n, j, inc, Time, "local");
+                                if (results) {
+                                    rve.output_columns(so, Time, "global", values);
+                                    results->push(i+1, n+1, j+1, inc+1, values);
+                                }
+                                else {
+                                    rve.output(so, i, n, j, inc, Time, "global");
+                                    rve.output(so, i, n, j, inc, Time, "local");
+                                }
                                 
                                 if (so.o_type(i) == 1) {
                                     o_ncount = 0;
@@ -350,8 +392,6 @@ void solver(const string &umat_name, const vec &props, const double &nstatev, co
                 /// resize the problem to solve
                 residual = zeros(7);
                 Delta = zeros(7);
-                K = zeros(7,7);
-                invK = zeros(7,7);
                 
                 shared_ptr<state_variables_T> sv_T;
                 
@@ -385,10 +425,10 @@ void solver(const string &umat_name, const vec &props, const double &nstatev, co
                 sv_T->Q = -1.*sv_T->r;    //Since DTime=0;
                 dQdT = lambda_solver;  //To avoid any singularity in the system                
                 
-                if(start) {
+                if((start)&&(results == nullptr)) {
                     //Use the number of phases saved to define the files
-                    rve.define_output(path_results, outputfile_global, "global");
-                    rve.define_output(path_results, outputfile_local, "local");
+                    rve.define_output(path_results, outputfile_global, "global", so, writer);
+                    rve.define_output(path_results, outputfile_local, "local", so, writer);
                     //Write the initial results
 //                    rve.output(so, -1, -1, -1, -1, Time, "global");
 //                    rve.output(so, -1, -1, -1, -1, Time, "local");
@@ -480,13 +520,20 @@ void solver(const string &umat_name, const vec &props, const double &nstatev, co
                                         
                                         ///Prediction of the strain increment using the tangent modulus given from the umat_ function
                                         //we use the ddsdde (Lt) from the previous increment
-                                        Lth_2_K(sv_T->dSdE, sv_T->dSdT, dQdE, dQdT, K, sptr_thermomeca->cBC_meca, sptr_thermomeca->cBC_T, lambda_solver);
-                                        
-                                        ///jacobian inversion
-                                        invK = inv(K);
+                                        //With the modified Newton method, the factorization of the first iteration is kept until the end of the increment
+                                        if ((modified_newton_solver == 0)||(compteur == 0)) {
+                                            Lth_2_K(sv_T->dSdE, sv_T->dSdT, dQdE, dQdT, K_thermomeca, sptr_thermomeca->cBC_meca, sptr_thermomeca->cBC_T, lambda_solver);
+                                            
+                                            ///jacobian factorization
+                                            if (!K_thermomeca.factorize()) {
+                                                cout << "error : The jacobian of the mixed problem is singular\n";
+                                                return;
+                                            }
+                                        }
                                         
                                         /// Prediction of the component of the strain tensor
-                                        Delta = -invK * residual;
+                                        K_thermomeca.solve(residual, Delta);
+                                        Delta *= -1.;
                                         
                                         for(int k = 0 ; k < 6 ; k++)
                                         {
@@ -621,8 +668,14 @@ void solver(const string &umat_name, const vec &props, const double &nstatev, co
                             //Write the results
                             if (((so.o_type(i) == 1)&&(o_ncount == so.o_nfreq(i)))||(((so.o_type(i) == 2)&&(fabs(o_tcount - so.o_tfreq(i)) < 1.E-12)))) {
                     
-                                rve.output(so, i, n, j, inc, Time, "global");
-                                rve.output(so, i, n, j, inc, Time, "local");
+                                if (results) {
+                                    rve.output_columns(so, Time, "global", values);
+                                    results->push(i+1, n+1, j+1, inc+1, values);
+                                }
+                                else {
+                                    rve.output(so, i, n, j, inc, Time, "global");
+                                    rve.output(so, i, n, j, inc, Time, "local");
+                                }
                                 if (so.o_type(i) == 1) {
                                     o_ncount = 0;
                                 }
@@ -0,0 +1,202 @@
+/* This file is part of SMART+.
+ 
+ SMART+ is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ SMART+ is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with SMART+.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+
+///@file solver_context.cpp
+///@brief Loading path, outputs and microstructure read once, for several runs of the solver
+///@version 1.0
+
+#include <iostream>
+#include <string>
+#include <assert.h>
+#include <armadillo>
+#include <boost/filesystem.hpp>
+#include <smartplus/Libraries/Solver/solver_context.hpp>
+#include <smartplus/Libraries/Solver/read.hpp>
+#include <smartplus/Libraries/Solver/solver.hpp>
+#include <smartplus/Umat/umat_registry.hpp>
+#include <smartplus/Micromechanics/multiphase.hpp>
+
+using namespace std;
+using namespace arma;
+
+namespace smart{
+
+//=====Private methods for solver_context===================================
+
+//Initial state of the RVE, the microstructure is read at the first run
+//-------------------------------------------------------------
+void solver_context::initialize()
+//-------------------------------------------------------------
+{
+    umat_id = find_umat(umat_name);
+    micro_read = false;
+    props_micro = zeros(4);
+    
+    rve_init = phase_characteristics();
+    if (blocks.size() > 0) {
+        rve_init.construct(0, blocks[0].type);
+        rve_init.sptr_sv_global->update(zeros(6), zeros(6), zeros(6), zeros(6), T_init, 0., nstatev, zeros(nstatev), zeros(nstatev));
+    }
+    rve = phase_characteristics();
+    results.clear();
+}
+
+//=====Public methods for solver_context============================================
+
+//@brief default constructor
+//-------------------------------------------------------------
+solver_context::solver_context()
+//-------------------------------------------------------------
+{
+    micro_read = false;
+    umat_id = 0;
+    nstatev = 0;
+    psi_rve = 0.;
+    theta_rve = 0.;
+    phi_rve = 0.;
+    T_init = 0.;
+}
+
+/*!
+  \brief Constructor that reads the loading path (see read_path) and the outputs (see read_output) in the folder path_data
+*/
+
+//-------------------------------------------------------------
+solver_context::solver_context(const string &mumat_name, const int &mnstatev, const double &mpsi_rve, const double &mtheta_rve, const double &mphi_rve, const string &path_data, const string &pathfile, const string &output_info_file)
+//-------------------------------------------------------------
+{
+    umat_name = mumat_name;
+    nstatev = mnstatev;
+    psi_rve = mpsi_rve;
+    theta_rve = mtheta_rve;
+    phi_rve = mphi_rve;
+    T_init = 0.;
+    
+    //Check if the required directories exist:
+    if(!boost::filesystem::is_directory(path_data)) {
+        cout << "error: the folder for the data, " << path_data << ", is not present" << endl;
+        exit(0);
+    }
+    
+    read_path(blocks, T_init, path_data, pathfile);
+    so = solver_output(blocks.size());
+    read_output(so, blocks.size(), nstatev, path_data, output_info_file);
+    check_path_output(blocks, so);
+    
+    initialize();
+}
+
+/*!
+  \brief Constructor with the loading path and the outputs already read
+*/
+
+//-------------------------------------------------------------
+solver_context::solver_context(const string &mumat_name, const int &mnstatev, const double &mpsi_rve, const double &mtheta_rve, const double &mphi_rve, const std::vector<block> &mblocks, const double &mT_init, const solver_output &mso)
+//-------------------------------------------------------------
+{
+    umat_name = mumat_name;
+    nstatev = mnstatev;
+    psi_rve = mpsi_rve;
+    theta_rve = mtheta_rve;
+    phi_rve = mphi_rve;
+    blocks = mblocks;
+    T_init = mT_init;
+    so = mso;
+    
+    initialize();
+}
+
+/*!
+  \brief Copy constructor
+  \param sc solver_context object to duplicate
+*/
+
+//------------------------------------------------------
+solver_context::solver_context(const solver_context& sc)
+//------------------------------------------------------
+{
+    *this = sc;
+}
+
+/*!
+  \brief destructor
+*/
+
+solver_context::~solver_context() {}
+
+//-------------------------------------------------------------
+mat solver_context::run(const vec &props)
+//-------------------------------------------------------------
+{
+    assert(blocks.size() > 0);
+    
+    //The microstructure of a multiphase material depends on the number of phases, the number of the file and the integration points
+    if (find_scheme(umat_id) != NULL) {
+        assert(props.n_elem >= 4);
+        if ((!micro_read)||(any(props.head(4) != props_micro))) {
+            rve_init.sub_phases.clear();
+            rve_init.sptr_matprops->update(0, umat_name, 1, psi_rve, theta_rve, phi_rve, props.n_elem, props);
+            read_multi(rve_init, umat_id);
+            props_micro = props.head(4);
+            micro_read = true;
+        }
+    }
+    
+    rve.copy(rve_init);
+    rve.sptr_matprops->update(0, umat_name, 1, psi_rve, theta_rve, phi_rve, props.n_elem, props);
+    
+    solver(rve, nstatev, blocks, T_init, so, "results", "result_job.txt", &results);
+    return results.records();
+}
+
+//-------------------------------------------------------------
+void solver_context::reset()
+//-------------------------------------------------------------
+{
+    initialize();
+}
+
+/*!
+  \brief Standard operator = for solver_context. The RVE are deep copies (see phase_characteristics::copy)
+*/
+
+//----------------------------------------------------------------------
+solver_context& solver_context::operator = (const solver_context& sc)
+//----------------------------------------------------------------------
+{
+    micro_read = sc.micro_read;
+    props_micro = sc.props_micro;
+    umat_name = sc.umat_name;
+    umat_id = sc.umat_id;
+    nstatev = sc.nstatev;
+    psi_rve = sc.psi_rve;
+    theta_rve = sc.theta_rve;
+    phi_rve = sc.phi_rve;
+    blocks = sc.blocks;
+    T_init = sc.T_init;
+    so = sc.so;
+    
+    rve_init = phase_characteristics();
+    if (sc.rve_init.sptr_sv_global)
+        rve_init.copy(sc.rve_init);
+    rve = phase_characteristics();
+    results = sc.results;
+    
+	return *this;
+}
+
+} //namespace smart
@@ -25,15 +25,19 @@
 #include <assert.h>
 #include <armadillo>
 #include <memory>
+#include <map>
 #include <smartplus/Libraries/Continuum_Mechanics/constitutive.hpp>
 #include <smartplus/Micromechanics/multiphase.hpp>
 #include <smartplus/parameter.hpp>
+#include <smartplus/Libraries/Maths/anderson.hpp>
 #include <smartplus/Umat/umat_smart.hpp>
 #include <smartplus/Libraries/Phase/state_variables_M.hpp>
 #include <smartplus/Libraries/Phase/read.hpp>
 #include <smartplus/Libraries/Homogenization/ellipsoid_multi.hpp>
 #include <smartplus/Libraries/Homogenization/eshelby.hpp>
 #include <smartplus/Micromechanics/schemes.hpp>
+#include <smartplus/Umat/umat_L_elastic.hpp>
+#include <smartplus/Umat/umat_registry.hpp>
 #include <smartplus/Umat/umat_smart.hpp>
 
 using namespace std;
@@ -49,50 +53,32 @@ namespace smart{
 
 ///@brief The table Nphases.dat will store the necessary informations about the geometry of the phases and the material properties
 
-void umat_multi(phase_characteristics &phase, const mat &DR, const double &Time, const double &DTime, const int &ndi, const int &nshr, const bool &start, double &tnew_dt, const int &method)
+//Multiphase UMAT specialized for a homogenization scheme of schemes.hpp
+template<typename scheme> static void umat_multi_scheme(phase_characteristics &phase, const mat &DR, const double &Time, const double &DTime, const int &ndi, const int &nshr, const bool &start, double &tnew_dt, const int &accelerator)
 {
 
     int nphases = phase.sptr_matprops->props(0); // Number of phases
-    string path_data = "data";
-    string inputfile; //file # that stores the microstructure properties
     
-    shared_ptr<state_variables_M> umat_phase_M = std::dynamic_pointer_cast<state_variables_M>(phase.sptr_sv_local); //shared_ptr on state variables of the rve
-    shared_ptr<state_variables_M> umat_sub_phases_M; //shared_ptr on state variables
-    
-    //1 - We need to figure out the type of geometry and read the phase
-    if(start) {
-        switch (method) {
-                
-            case 100: case 101: case 102: case 103: {
-                //Definition of the static vectors x,wx,y,wy
-                ellipsoid_multi::mp = phase.sptr_matprops->props(2);
-                ellipsoid_multi::np = phase.sptr_matprops->props(3);
-                ellipsoid_multi::x.set_size(ellipsoid_multi::mp);
-                ellipsoid_multi::wx.set_size(ellipsoid_multi::mp);
-                ellipsoid_multi::y.set_size(ellipsoid_multi::np);
-                ellipsoid_multi::wy.set_size(ellipsoid_multi::np);
-                points(ellipsoid_multi::x, ellipsoid_multi::wx, ellipsoid_multi::y, ellipsoid_multi::wy,ellipsoid_multi::mp, ellipsoid_multi::np);
-                
-                inputfile = "Nellipsoids" + to_string(int(phase.sptr_matprops->props(1))) + ".dat";
-                read_ellipsoid(phase, path_data, inputfile);
-                break;
-            }
-            case 104: {
-                inputfile = "Nlayers" + to_string(int(phase.sptr_matprops->props(1))) + ".dat";
-                read_layer(phase, path_data, inputfile);
-                break;
-            }
-        }
+    //1 - We need to read the phases, with the geometry of the scheme, unless they have been read before the run (see read_multi)
+    if((start)&&(phase.sub_phases.empty())) {
+        scheme::read(phase);
     }
     
+    //The sub-phases are independent once their strain increment is known: they are updated in parallel if nthreads_micro > 1 (see parameter.hpp).
+    //Each phase proposes its own time step, reduced afterwards in the order of the phases
+    vec tnew_dt_phases = zeros(nphases);
+    
 	//Initialization
 	if (start) {
         
+        tnew_dt_phases.fill(tnew_dt);
+        #pragma omp parallel for num_threads(nthreads_micro) if(nthreads_micro > 1) schedule(static)
         for (int i=0; i<nphases; i++) {
             //Run the appropriate constitutive model
             
-            select_umat_M(phase.sub_phases[i], DR, Time, DTime, ndi, nshr, start, tnew_dt);
+            select_umat_M(phase.sub_phases[i], DR, Time, DTime, ndi, nshr, start, tnew_dt_phases(i));
         }
+        tnew_dt = tnew_dt_phases.min();
     }
 
     // Preliminaries of the convergence loop
@@ -100,6 +86,11 @@ void umat_multi(phase_characteristics &phase, const mat &DR, const double &Time,
     double error = 1.;
     std::vector<vec> DEtot_N(nphases); //Table that stores all the previous increments of strain
     
+    //Anderson mixing of the fixed point on the strain increments of the phases, used if accelerator == 1 (see accelerator_micro in parameter.hpp)
+    Anderson_mixing anderson(anderson_depth_micro);
+    vec DEtot_x = zeros(6*nphases);    //Strain increments of all the phases before the localization
+    vec DEtot_g = zeros(6*nphases);    //Strain increments of all the phases given by the localization
+    
 	//Convergence loop, localization
 	while ((error > precision_micro)&&(nbiter <= maxiter_micro)) {
 	  
@@ -109,88 +100,114 @@ void umat_multi(phase_characteristics &phase, const mat &DR, const double &Time,
 
         //Compute the strain concentration tensor for each phase:
         //Also update of all the local strain increment
-        switch (method) {
-                
-            case 100: {
-                DE_Homogeneous_E(phase);
-                break;
-            }
-            case 101: {
-                int n_matrix = phase.sptr_matprops->props(4);
-                DE_Mori_Tanaka(phase, n_matrix);
-                break;
-            }
-            case 102: {
-                int n_matrix = phase.sptr_matprops->props(4);
-                DE_Self_Consistent(phase, n_matrix, start, 0);
-                break;
+        scheme::localize(phase, start, nbiter);
+        
+        //Newton localization: the phases have been evaluated at DEtot_N, the first localization gives the initial guess
+        if ((accelerator == 2)&&(nbiter > 0)&&((scheme::id == 101)||(scheme::id == 102))) {
+            int n_matrix = phase.sptr_matprops->props(4);
+            int method = scheme::id;
+            DE_Newton_localization(phase, n_matrix, DEtot_N, method);
+        }
+        
+        error = 0.;
+        for(int i=0; i<nphases; i++) {
+            error += norm(DEtot_N[i] - phase.sub_phases[i].sptr_sv_global->DEtot,2);
+        }
+        error*=(1./nphases);
+        
+        //The first localization initializes the increments (for instance periodic layers start from the effective one), it is never mixed
+        if ((accelerator == 1)&&(nbiter > 0)) {
+            for(int i=0; i<nphases; i++) {
+                DEtot_x.subvec(6*i, 6*i+5) = DEtot_N[i];
+                DEtot_g.subvec(6*i, 6*i+5) = phase.sub_phases[i].sptr_sv_global->DEtot;
             }
-            case 104: {
-                dE_Periodic_Layer(phase, nbiter);
-                break;
+            vec DEtot_mix = anderson.update(DEtot_x, DEtot_g);
+            for(int i=0; i<nphases; i++) {
+                phase.sub_phases[i].sptr_sv_global->DEtot = DEtot_mix.subvec(6*i, 6*i+5);
             }
-        
         }
     
-        for (auto r : phase.sub_phases) {
-            r.sptr_sv_global->to_start();
+        tnew_dt_phases.fill(tnew_dt);
+        #pragma omp parallel for num_threads(nthreads_micro) if(nthreads_micro > 1) schedule(static)
+        for (int i=0; i<nphases; i++) {
+            phase.sub_phases[i].sptr_sv_global->to_start();
             
             //Theta method for the tangent modulus
             //mat Lt_start = umat_sub_phases_M->Lt
-            select_umat_M(r, DR, Time, DTime, ndi, nshr, start, tnew_dt);
+            select_umat_M(phase.sub_phases[i], DR, Time, DTime, ndi, nshr, start, tnew_dt_phases(i));
 
             //Theta method for the tangent modulus
-            //umat_sub_phases_M = std::dynamic_pointer_cast<state_variables_M>(r.sptr_sv_global);
+            //umat_sub_phases_M = r.sv_global_as<state_variables_M>();
             //Lt* = (1 - (2./3.))*Lt_start + 2./3.*Lt;
         }
-        
-        error = 0.;
-        for(int i=0; i<nphases; i++) {
-            error += norm(DEtot_N[i] - phase.sub_phases[i].sptr_sv_global->DEtot,2);
-        }
-        error*=(1./nphases);
+        tnew_dt = tnew_dt_phases.min();
     
         nbiter++;
 	}
+    phase.sptr_multi->nbiter = nbiter;
     
     //Now we can calculate the concentration tensors only for the tangent modulus
-    switch (method) {
-            
-            case 100: {
-                Lt_Homogeneous_E(phase);
-                break;
-            }
-            case 101: {
-                int n_matrix = phase.sptr_matprops->props(4);
-                Lt_Mori_Tanaka(phase, n_matrix);
-                break;
-            }
-            case 102: {
-                int n_matrix = phase.sptr_matprops->props(4);
-                Lt_Self_Consistent(phase, n_matrix, start, 0);
-                break;
-            }
-            case 104: {
-                Lt_Periodic_Layer(phase);
-                break;
-            }
-            
-    }
+    scheme::tangent(phase, start);
     
     //	Homogenization
-	//Compute the effective stress
-	umat_phase_M->sigma = zeros(6);
-    for (auto r : phase.sub_phases) {
-		umat_phase_M->sigma += r.sptr_shape->concentration*r.sptr_sv_global->sigma;
-	}
+	//Compute the effective stress and the effective tangent modulus
+    scheme::homogenize(phase);
+}
+
+//Table of the multiphase schemes, filled from the list multiphase_schemes with their id
+static void add_schemes(std::map<int, multiphase_scheme> &, scheme_list<>) {}
+
+template<typename scheme, typename... schemes> static void add_schemes(std::map<int, multiphase_scheme> &table, scheme_list<scheme, schemes...>)
+{
+    multiphase_scheme entry = {umat_multi_scheme<scheme>, get_L_elastic_scheme<scheme>, scheme::read};
+    table[scheme::id] = entry;
+    add_schemes(table, scheme_list<schemes...>());
+}
+
+static std::map<int, multiphase_scheme> multiphase_scheme_table()
+{
+    std::map<int, multiphase_scheme> table;
+    add_schemes(table, multiphase_schemes());
+    return table;
+}
+
+const multiphase_scheme* find_scheme(const int &id)
+{
+    static std::map<int, multiphase_scheme> table = multiphase_scheme_table();
     
-    umat_phase_M->Lt = zeros(6,6);
-	// Compute the effective tangent modulus, and the effective stress
-    for (auto r : phase.sub_phases) {
-        umat_sub_phases_M = std::dynamic_pointer_cast<state_variables_M>(r.sptr_sv_global);
-		umat_phase_M->Lt += r.sptr_shape->concentration*(umat_sub_phases_M->Lt*r.sptr_multi->A);
-	}
+    auto it = table.find(id);
+    if (it == table.end())
+        return NULL;
+    return &(it->second);
+}
     
+void umat_multi(phase_characteristics &phase, const mat &DR, const double &Time, const double &DTime, const int &ndi, const int &nshr, const bool &start, double &tnew_dt, const int &method, const int &accelerator)
+{
+    //The scheme is found once per call, the localization loop is then specialized for it
+    const multiphase_scheme *scheme = find_scheme(method);
+    if (scheme == NULL) {
+        cout << "Error: The multiphase scheme " << method << " (" << phase.sptr_matprops->umat_name << ") is not available\n";
+        exit(0);
+    }
+    scheme->umat(phase, DR, Time, DTime, ndi, nshr, start, tnew_dt, accelerator);
+}
+
+void read_multi(phase_characteristics &phase, const int &method)
+{
+    const multiphase_scheme *scheme = find_scheme(method);
+    if (scheme == NULL) {
+        cout << "Error: The multiphase scheme " << method << " (" << phase.sptr_matprops->umat_name << ") is not available\n";
+        exit(0);
+    }
+    scheme->read(phase);
+    
+    //The phases that are themselves multiphase materials read their own microstructure
+    for (auto &r : phase.sub_phases) {
+        if (r.sptr_matprops->umat_id == umat_unknown)
+            r.sptr_matprops->umat_id = find_umat(r.sptr_matprops->umat_name);
+        if (find_scheme(r.sptr_matprops->umat_id) != NULL)
+            read_multi(r, r.sptr_matprops->umat_id);
+    }
 }
 
 } //namespace smart
@@ -26,6 +26,7 @@
 #include <assert.h>
 #include <armadillo>
 #include <memory>
+#include <smartplus/parameter.hpp>
 #include <smartplus/Libraries/Maths/rotation.hpp>
 #include <smartplus/Libraries/Phase/phase_characteristics.hpp>
 #include <smartplus/Libraries/Phase/state_variables.hpp>
@@ -33,12 +34,14 @@
 #include <smartplus/Libraries/Geometry/geometry.hpp>
 #include <smartplus/Libraries/Geometry/layer.hpp>
 #include <smartplus/Libraries/Geometry/ellipsoid.hpp>
-// #include <smartplus/Libraries/Geometry/cylinder.hpp>
+#include <smartplus/Libraries/Geometry/cylinder.hpp>
 #include <smartplus/Libraries/Homogenization/phase_multi.hpp>
 #include <smartplus/Libraries/Homogenization/layer_multi.hpp>
 #include <smartplus/Libraries/Homogenization/ellipsoid_multi.hpp>
-// #include <smartplus/Libraries/Homogenization/cylinder_multi.hpp>
+#include <smartplus/Libraries/Homogenization/cylinder_multi.hpp>
 #include <smartplus/Libraries/Homogenization/eshelby.hpp>
+#include <smartplus/Libraries/Phase/read.hpp>
+#include <smartplus/Micromechanics/schemes.hpp>
 
 using namespace std;
 using namespace arma;
@@ -48,18 +51,19 @@ namespace smart{
 void Lt_Homogeneous_E(phase_characteristics &phase) {
     
     //Compute the strain concentration tensor A
-    for(auto r : phase.sub_phases) {
+    for(auto &r : phase.sub_phases) {
         r.sptr_multi->A = eye(6,6);
     }
 }
 
 void DE_Homogeneous_E(phase_characteristics &phase) {
     
-    std::shared_ptr<state_variables_M> sv_r;
-    std::shared_ptr<state_variables_M> sv_eff = std::dynamic_pointer_cast<state_variables_M>(phase.sptr_sv_local);
+    state_variables_M *sv_r;
+    state_variables_M *sv_eff = phase.sv_local_as<state_variables_M>();
     
     //Compute the strain concentration tensor A
-    for(auto r : phase.sub_phases) {
+    for(auto &r : phase.sub_phases) {
+        sv_r = r.sv_global_as<state_variables_M>();
         r.sptr_multi->A = eye(6,6);
         sv_r->DEtot = r.sptr_multi->A*sv_eff->DEtot; //Recall that the global coordinates of subphases is the local coordinates of the generic phase
     }
@@ -70,35 +74,38 @@ void Lt_Mori_Tanaka(phase_characteristics &phase, const int &n_matrix) {
     mat sumT = zeros(6,6);
     mat inv_sumT = zeros(6,6);
 
-    std::shared_ptr<ellipsoid_multi> elli_multi;
-    std::shared_ptr<ellipsoid> elli;
+    ellipsoid_multi *elli_multi;
+    ellipsoid *elli;
     //ptr on the matrix properties
-    std::shared_ptr<state_variables_M> sv_0 = std::dynamic_pointer_cast<state_variables_M>(phase.sub_phases[n_matrix].sptr_sv_global);
-    std::shared_ptr<state_variables_M> sv_eff = std::dynamic_pointer_cast<state_variables_M>(phase.sptr_sv_local);
-    std::shared_ptr<state_variables_M> sv_r;
-    
-    //Compute the Eshelby tensor and the interaction tensor for each phase
-    for(auto r : phase.sub_phases) {
-        elli_multi = std::dynamic_pointer_cast<ellipsoid_multi>(r.sptr_multi);
-        elli = std::dynamic_pointer_cast<ellipsoid>(r.sptr_shape);
-        sv_r = std::dynamic_pointer_cast<state_variables_M>(r.sptr_sv_global);
+    state_variables_M *sv_0 = phase.sub_phases[n_matrix].sv_global_as<state_variables_M>();
+    
+    //Compute the Eshelby tensor and the interaction tensor for each phase (independent, in parallel if nthreads_micro > 1)
+    int nphases = int(phase.sub_phases.size());
+    #pragma omp parallel for num_threads(nthreads_micro) if(nthreads_micro > 1) schedule(static)
+    for(int i=0; i<nphases; i++) {
+        ellipsoid_multi *elli_multi_i = phase.sub_phases[i].multi_as<ellipsoid_multi>();
+        ellipsoid *elli_i = phase.sub_phases[i].shape_as<ellipsoid>();
+        state_variables_M *sv_i = phase.sub_phases[i].sv_global_as<state_variables_M>();
         
         //Note The tangent modulus are turned in the coordinate system of the ellipspoid in the fillT function
-        //Note The tangent modulus are turned in the coordinate system of the ellipspoid in the fillT function
-        if (r.sptr_matprops->number == n_matrix)
-            elli_multi->T = eye(6,6);
+        if (phase.sub_phases[i].sptr_matprops->number == n_matrix)
+            elli_multi_i->T = eye(6,6);
         else
-            elli_multi->fillT(sv_0->Lt, sv_r->Lt, *elli);
-
-        //Compute the normalization interaction tensir sumT
-		sumT += elli->concentration*elli_multi->T;
+            elli_multi_i->fillT(sv_0->Lt, sv_i->Lt, *elli_i);
+    }
+    
+    //Compute the normalization interaction tensir sumT, always summed in the order of the phases
+    for(auto &r : phase.sub_phases) {
+        elli_multi = r.multi_as<ellipsoid_multi>();
+        elli = r.shape_as<ellipsoid>();
+        sumT += elli->concentration*elli_multi->T;
     }
 				
     inv_sumT = inv(sumT);
     
     //Compute the strain concentration tensor A
-    for(auto r : phase.sub_phases) {
-        elli_multi = std::dynamic_pointer_cast<ellipsoid_multi>(r.sptr_multi);
+    for(auto &r : phase.sub_phases) {
+        elli_multi = r.multi_as<ellipsoid_multi>();
         elli_multi->A = elli_multi->T*inv_sumT;
     }
 }
@@ -108,48 +115,158 @@ void DE_Mori_Tanaka(phase_characteristics &phase, const int &n_matrix) {
     mat sumT = zeros(6,6);
     mat inv_sumT = zeros(6,6);
     
-    std::shared_ptr<ellipsoid_multi> elli_multi;
-    std::shared_ptr<ellipsoid> elli;
+    ellipsoid_multi *elli_multi;
+    ellipsoid *elli;
     //ptr on the matrix properties
-    std::shared_ptr<state_variables_M> sv_0 = std::dynamic_pointer_cast<state_variables_M>(phase.sub_phases[n_matrix].sptr_sv_global);
-    std::shared_ptr<state_variables_M> sv_eff = std::dynamic_pointer_cast<state_variables_M>(phase.sptr_sv_local);
-    std::shared_ptr<state_variables_M> sv_r;
-    
-    //Compute the Eshelby tensor and the interaction tensor for each phase
-    for(auto r : phase.sub_phases) {
-        elli_multi = std::dynamic_pointer_cast<ellipsoid_multi>(r.sptr_multi);
-        elli = std::dynamic_pointer_cast<ellipsoid>(r.sptr_shape);
-        sv_r = std::dynamic_pointer_cast<state_variables_M>(r.sptr_sv_global);
+    state_variables_M *sv_0 = phase.sub_phases[n_matrix].sv_global_as<state_variables_M>();
+    state_variables_M *sv_eff = phase.sv_local_as<state_variables_M>();
+    state_variables_M *sv_r;
+    
+    //Compute the Eshelby tensor and the interaction tensor for each phase (independent, in parallel if nthreads_micro > 1)
+    int nphases = int(phase.sub_phases.size());
+    #pragma omp parallel for num_threads(nthreads_micro) if(nthreads_micro > 1) schedule(static)
+    for(int i=0; i<nphases; i++) {
+        ellipsoid_multi *elli_multi_i = phase.sub_phases[i].multi_as<ellipsoid_multi>();
+        ellipsoid *elli_i = phase.sub_phases[i].shape_as<ellipsoid>();
+        state_variables_M *sv_i = phase.sub_phases[i].sv_global_as<state_variables_M>();
         
         //Note The tangent modulus are turned in the coordinate system of the ellipspoid in the fillT function
-        if (r.sptr_matprops->number == n_matrix)
-            elli_multi->T = eye(6,6);
+        if (phase.sub_phases[i].sptr_matprops->number == n_matrix)
+            elli_multi_i->T = eye(6,6);
         else
-            elli_multi->fillT(sv_0->Lt, sv_r->Lt, *elli);
-
-        //Compute the normalization interaction tensir sumT
+            elli_multi_i->fillT(sv_0->Lt, sv_i->Lt, *elli_i);
+    }
+    
+    //Compute the normalization interaction tensir sumT, always summed in the order of the phases
+    for(auto &r : phase.sub_phases) {
+        elli_multi = r.multi_as<ellipsoid_multi>();
+        elli = r.shape_as<ellipsoid>();
         sumT += elli->concentration*elli_multi->T;
     }
     
     inv_sumT = inv(sumT);
     
     //Compute the strain concentration tensor A
-    for(auto r : phase.sub_phases) {
-        elli_multi = std::dynamic_pointer_cast<ellipsoid_multi>(r.sptr_multi);
-        sv_r = std::dynamic_pointer_cast<state_variables_M>(r.sptr_sv_global);
+    for(auto &r : phase.sub_phases) {
+        elli_multi = r.multi_as<ellipsoid_multi>();
+        sv_r = r.sv_global_as<state_variables_M>();
         
         elli_multi->A = elli_multi->T*inv_sumT;
         sv_r->DEtot = elli_multi->A*sv_eff->DEtot; //Recall that the global coordinates of subphases is the local coordinates of the generic phase
     }
 }
 
+//Mori-Tanaka scheme with infinite cylindrical inclusions: the interaction tensors use the closed-form Eshelby tensor of the cylinder, no integration points are required
+void Lt_Mori_Tanaka_cylinder(phase_characteristics &phase, const int &n_matrix) {
+    
+    mat sumT = zeros(6,6);
+    mat inv_sumT = zeros(6,6);
+    
+    cylinder_multi *cyl_multi;
+    cylinder *cyl;
+    //ptr on the matrix properties
+    state_variables_M *sv_0 = phase.sub_phases[n_matrix].sv_global_as<state_variables_M>();
+    
+    //Compute the Eshelby tensor and the interaction tensor for each phase (independent, in parallel if nthreads_micro > 1)
+    int nphases = int(phase.sub_phases.size());
+    #pragma omp parallel for num_threads(nthreads_micro) if(nthreads_micro > 1) schedule(static)
+    for(int i=0; i<nphases; i++) {
+        cylinder_multi *cyl_multi_i = phase.sub_phases[i].multi_as<cylinder_multi>();
+        cylinder *cyl_i = phase.sub_phases[i].shape_as<cylinder>();
+        state_variables_M *sv_i = phase.sub_phases[i].sv_global_as<state_variables_M>();
+        
+        //Note The tangent modulus are turned in the coordinate system of the cylinder in the fillT function
+        if (phase.sub_phases[i].sptr_matprops->number == n_matrix)
+            cyl_multi_i->T = eye(6,6);
+        else
+            cyl_multi_i->fillT(sv_0->Lt, sv_i->Lt, *cyl_i);
+    }
+    
+    //Compute the normalization interaction tensir sumT, always summed in the order of the phases
+    for(auto &r : phase.sub_phases) {
+        cyl_multi = r.multi_as<cylinder_multi>();
+        cyl = r.shape_as<cylinder>();
+        sumT += cyl->concentration*cyl_multi->T;
+    }
+    
+    inv_sumT = inv(sumT);
+    
+    //Compute the strain concentration tensor A
+    for(auto &r : phase.sub_phases) {
+        cyl_multi = r.multi_as<cylinder_multi>();
+        cyl_multi->A = cyl_multi->T*inv_sumT;
+    }
+}
+    
+void DE_Mori_Tanaka_cylinder(phase_characteristics &phase, const int &n_matrix) {
+    
+    state_variables_M *sv_eff = phase.sv_local_as<state_variables_M>();
+    state_variables_M *sv_r;
+    
+    Lt_Mori_Tanaka_cylinder(phase, n_matrix);
+    
+    for(auto &r : phase.sub_phases) {
+        sv_r = r.sv_global_as<state_variables_M>();
+        sv_r->DEtot = r.sptr_multi->A*sv_eff->DEtot; //Recall that the global coordinates of subphases is the local coordinates of the generic phase
+    }
+}
+
+//Inner fixed point of the self-consistent scheme: the interaction tensors are computed in the effective medium sv_eff->Lt until Lt_eff = sum_r c_r*Lt_r*T_r.
+//sv_eff->Lt holds the converged effective tangent of the previous call (or the guess of the start), so that most increments need one or two passes.
+static void fillT_Self_Consistent(phase_characteristics &phase, const int &n_matrix) {
+    
+    state_variables_M *sv_eff = phase.sv_local_as<state_variables_M>();
+    int nphases = int(phase.sub_phases.size());
+    
+    mat Lt_eff = zeros(6,6);
+    int nbiter = 0;
+    double error = 1.;
+    
+    while ((error > precision_self_consistent)&&(nbiter < maxiter_self_consistent)) {
+        
+        //Compute the Eshelby tensor and the interaction tensor for each phase (independent, in parallel if nthreads_micro > 1)
+        #pragma omp parallel for num_threads(nthreads_micro) if(nthreads_micro > 1) schedule(static)
+        for(int i=0; i<nphases; i++) {
+            ellipsoid_multi *elli_multi_i = phase.sub_phases[i].multi_as<ellipsoid_multi>();
+            ellipsoid *elli_i = phase.sub_phases[i].shape_as<ellipsoid>();
+            state_variables_M *sv_i = phase.sub_phases[i].sv_global_as<state_variables_M>();
+            
+            //Note The tangent modulus are turned in the coordinate system of the ellipspoid in the fillT function
+            if (phase.sub_phases[i].sptr_matprops->number == n_matrix)
+                elli_multi_i->T = eye(6,6);
+            else
+                elli_multi_i->fillT(sv_eff->Lt, sv_i->Lt, *elli_i);
+        }
+        
+        //Effective tangent given by these interaction tensors, summed in the order of the phases
+        Lt_eff.zeros();
+        for(auto &r : phase.sub_phases) {
+            Lt_eff += r.sptr_shape->concentration*(r.sv_global_as<state_variables_M>()->Lt*r.multi_as<ellipsoid_multi>()->T);
+        }
+        
+        double norm_eff = norm(sv_eff->Lt,2);
+        error = (norm_eff > iota) ? norm(Lt_eff - sv_eff->Lt,2)/norm_eff : norm(Lt_eff,2);
+        sv_eff->Lt = Lt_eff;
+        nbiter++;
+    }
+    phase.sptr_multi->nbiter_self_consistent = nbiter;
+    
+    //The last estimate is kept, as the solver does when it is enforced to proceed
+    if (error > precision_self_consistent) {
+        cout << "The self-consistent scheme has not converged after " << maxiter_self_consistent << " iterations, for the phase " << phase.sptr_matprops->number << " (" << phase.sptr_matprops->umat_name << "), with the error: " << error << "\n";
+    }
+    
+    //Compute the strain concentration tensor A
+    for(auto &r : phase.sub_phases) {
+        r.sptr_multi->A = r.multi_as<ellipsoid_multi>()->T;
+    }
+}
+
 void Lt_Self_Consistent(phase_characteristics &phase, const int &n_matrix, const bool &start, const int &option_start) {
     
-    std::shared_ptr<ellipsoid_multi> elli_multi;
-    std::shared_ptr<ellipsoid> elli;
     //ptr on the matrix properties
-    std::shared_ptr<state_variables_M> sv_r;
-    std::shared_ptr<state_variables_M> sv_eff = std::dynamic_pointer_cast<state_variables_M>(phase.sptr_sv_local);
+    state_variables_M *sv_r;
+    state_variables_M *sv_eff = phase.sv_local_as<state_variables_M>();
     
     //In the self_consistent scheme we need to have the effective tangent modulus first, based on some guessed initial concentration tensor.
     if(start) {
@@ -164,38 +281,22 @@ void Lt_Self_Consistent(phase_characteristics &phase, const int &n_matrix, const
         
         //Compute the effective tensor from the previous strain localization tensors
         mat Lt_eff = zeros(6,6);
-        for(auto r : phase.sub_phases) {
-            sv_r = std::dynamic_pointer_cast<state_variables_M>(r.sptr_sv_global);
+        for(auto &r : phase.sub_phases) {
+            sv_r = r.sv_global_as<state_variables_M>();
             Lt_eff += r.sptr_shape->concentration*r.sptr_multi->A*sv_r->Lt;
         }
         sv_eff->Lt = Lt_eff;
     }
     
-    //Compute the Eshelby tensor and the interaction tensor for each phase
-    for(unsigned int i=0; i<phase.sub_phases.size(); i++) {
-        elli_multi = std::dynamic_pointer_cast<ellipsoid_multi>(phase.sub_phases[i].sptr_multi);
-        elli = std::dynamic_pointer_cast<ellipsoid>(phase.sub_phases[i].sptr_shape);
-        sv_r = std::dynamic_pointer_cast<state_variables_M>(phase.sub_phases[i].sptr_sv_global);
-        
-        //Note The tangent modulus are turned in the coordinate system of the ellipspoid in the fillT function
-        if (phase.sub_phases[i].sptr_matprops->number == n_matrix)
-            elli_multi->T = eye(6,6);
-        else
-            elli_multi->fillT(sv_eff->Lt, sv_r->Lt, *elli);
-        
-        //Compute the strain concentration tensor A
-        elli_multi->A = elli_multi->T;
-    }
-    
+    //Compute the interaction tensors and the strain concentration tensors, self-consistent with the effective tangent
+    fillT_Self_Consistent(phase, n_matrix);
 }
     
 void DE_Self_Consistent(phase_characteristics &phase, const int &n_matrix, const bool &start, const int &option_start) {
     
-    std::shared_ptr<ellipsoid_multi> elli_multi;
-    std::shared_ptr<ellipsoid> elli;
     //ptr on the matrix properties
-    std::shared_ptr<state_variables_M> sv_r;
-    std::shared_ptr<state_variables_M> sv_eff = std::dynamic_pointer_cast<state_variables_M>(phase.sptr_sv_local);
+    state_variables_M *sv_r;
+    state_variables_M *sv_eff = phase.sv_local_as<state_variables_M>();
 
     //In the self_consistent scheme we need to have the effective tangent modulus first, based on some guessed initial concentration tensor.
     if(start) {
@@ -210,44 +311,100 @@ void DE_Self_Consistent(phase_characteristics &phase, const int &n_matrix, const
         
         //Compute the effective tensor from the previous strain localization tensors
         mat Lt_eff = zeros(6,6);
-        for(auto r : phase.sub_phases) {
-            sv_r = std::dynamic_pointer_cast<state_variables_M>(r.sptr_sv_global);
+        for(auto &r : phase.sub_phases) {
+            sv_r = r.sv_global_as<state_variables_M>();
             Lt_eff += r.sptr_shape->concentration*r.sptr_multi->A*sv_r->Lt;
         }
         sv_eff->Lt = Lt_eff;
     }
     
-    //Compute the Eshelby tensor and the interaction tensor for each phase
-    for(unsigned int i=0; i<phase.sub_phases.size(); i++) {
-        elli_multi = std::dynamic_pointer_cast<ellipsoid_multi>(phase.sub_phases[i].sptr_multi);
-        elli = std::dynamic_pointer_cast<ellipsoid>(phase.sub_phases[i].sptr_shape);
-        sv_r = std::dynamic_pointer_cast<state_variables_M>(phase.sub_phases[i].sptr_sv_global);
-        
-        //Note The tangent modulus are turned in the coordinate system of the ellipspoid in the fillT function
-        if (phase.sub_phases[i].sptr_matprops->number == n_matrix)
-            elli_multi->T = eye(6,6);
-        else
-            elli_multi->fillT(sv_eff->Lt, sv_r->Lt, *elli);
+    //Compute the interaction tensors and the strain concentration tensors, self-consistent with the effective tangent
+    fillT_Self_Consistent(phase, n_matrix);
+    
+    for(auto &r : phase.sub_phases) {
+        sv_r = r.sv_global_as<state_variables_M>();
+        sv_r->DEtot = r.sptr_multi->A*sv_eff->DEtot; //Recall that the global coordinates of subphases is the local coordinates of the generic phase
+    }
+}
+    
+//The residual is the incremental interaction law of each inclusion r with the reference medium (the matrix for Mori-Tanaka, the effective medium for the self-consistent scheme):
+//R_r = DE_r - DE_ref + S_r*inv(L_ref)*(Dsigma_r - L_ref*DE_r), which gives back the strain concentration tensor T_r for linear phases.
+//Mori-Tanaka closes the system with the average of the strain increments, the self-consistent scheme with DE_matrix = DE_eff (as A_matrix = I in DE_Self_Consistent).
+//The Eshelby tensors S_r are the ones computed by the last call of DE_Mori_Tanaka / DE_Self_Consistent, and the phase tangents give the Jacobian.
+void DE_Newton_localization(phase_characteristics &phase, const int &n_matrix, const std::vector<vec> &DEtot_N, const int &method) {
+    
+    assert((method == 101)||(method == 102));
+    int nphases = int(phase.sub_phases.size());
+    assert(int(DEtot_N.size()) == nphases);
+    
+    ellipsoid_multi *elli_multi;
+    ellipsoid *elli;
+    state_variables_M *sv_r;
+    state_variables_M *sv_0 = phase.sub_phases[n_matrix].sv_global_as<state_variables_M>();
+    state_variables_M *sv_eff = phase.sv_local_as<state_variables_M>();
+    
+    mat inv_L_ref = zeros(6,6);
+    if (method == 101)
+        inv_L_ref = inv(sv_0->Lt);
+    else
+        inv_L_ref = inv(sv_eff->Lt);
+    vec DE_ref = (method == 101) ? DEtot_N[n_matrix] : vec(sv_eff->DEtot);
+    
+    mat J = zeros(6*nphases, 6*nphases);
+    vec R = zeros(6*nphases);
+    mat S = zeros(6,6);
+    mat K = zeros(6,6);
+    
+    for(int i=0; i<nphases; i++) {
+        sv_r = phase.sub_phases[i].sv_global_as<state_variables_M>();
         
-        //Compute the strain concentration tensor A
-        elli_multi->A = elli_multi->T;
-        sv_r->DEtot = elli_multi->A*sv_eff->DEtot; //Recall that the global coordinates of subphases is the local coordinates of the generic phase
+        if (i == n_matrix) {
+            if (method == 101) {
+                R.subvec(6*i, 6*i+5) = -1.*sv_eff->DEtot;
+                for(int j=0; j<nphases; j++) {
+                    elli = phase.sub_phases[j].shape_as<ellipsoid>();
+                    R.subvec(6*i, 6*i+5) += elli->concentration*DEtot_N[j];
+                    J.submat(6*i, 6*j, 6*i+5, 6*j+5) = elli->concentration*eye(6,6);
+                }
+            }
+            else {
+                R.subvec(6*i, 6*i+5) = DEtot_N[i] - sv_eff->DEtot;
+                J.submat(6*i, 6*i, 6*i+5, 6*i+5) = eye(6,6);
+            }
+        }
+        else {
+            elli_multi = phase.sub_phases[i].multi_as<ellipsoid_multi>();
+            S = elli_multi->rot_geom.l2g_A(elli_multi->S_loc);
+            K = S*inv_L_ref;
+            
+            R.subvec(6*i, 6*i+5) = DEtot_N[i] - S*DEtot_N[i] - DE_ref + K*(sv_r->sigma - sv_r->sigma_start);
+            J.submat(6*i, 6*i, 6*i+5, 6*i+5) = eye(6,6) - S + K*sv_r->Lt;
+            if (method == 101)
+                J.submat(6*i, 6*n_matrix, 6*i+5, 6*n_matrix+5) = -1.*eye(6,6);
+        }
+    }
+    
+    //If the Jacobian is singular the increments of the fixed-point localization are kept
+    vec dx;
+    if (!solve(dx, J, -1.*R))
+        return;
+    
+    for(int i=0; i<nphases; i++) {
+        sv_r = phase.sub_phases[i].sv_global_as<state_variables_M>();
+        sv_r->DEtot = DEtot_N[i] + dx.subvec(6*i, 6*i+5);
     }
-
 }
     
 void dE_Periodic_Layer(phase_characteristics &phase, const int &nbiter) {
     
-    std::shared_ptr<layer_multi> lay_multi;
-    std::shared_ptr<layer> lay;
+    layer_multi *lay_multi;
+    layer *lay;
     //ptr on the matrix properties
-    std::shared_ptr<state_variables_M> sv_r;
-    std::shared_ptr<state_variables_M> sv_eff = std::dynamic_pointer_cast<state_variables_M>(phase.sptr_sv_local);
-    
-    mat Lt_loc = zeros(6,6);
+    state_variables_M *sv_r;
+    state_variables_M *sv_eff = phase.sv_local_as<state_variables_M>();
     
     if (nbiter == 0) {
-        for (auto r : phase.sub_phases) {
+        for (auto &r : phase.sub_phases) {
             r.sptr_sv_global->DEtot = sv_eff->DEtot;
         }
     }
@@ -255,109 +412,71 @@ void dE_Periodic_Layer(phase_characteristics &phase, const int &nbiter) {
     //Compute the increment of strain
     mat sumDnn = zeros(3,3);
 	vec sumcDsig = zeros(3);
-    for(auto r : phase.sub_phases) {
-        
-        sv_r = std::dynamic_pointer_cast<state_variables_M>(r.sptr_sv_global);
-        lay_multi = std::dynamic_pointer_cast<layer_multi>(r.sptr_multi);
-        lay = std::dynamic_pointer_cast<layer>(r.sptr_shape);
-        Lt_loc = rotate_g2l_L(sv_r->Lt, lay->psi_geom, lay->theta_geom, lay->phi_geom);
+    vec6 sigma_local;
+    for(auto &r : phase.sub_phases) {
         
-        lay_multi->Dnn(0,0) = Lt_loc(0,0);
-        lay_multi->Dnn(0,1) = Lt_loc(0,3);
-        lay_multi->Dnn(0,2) = Lt_loc(0,4);
-        lay_multi->Dnn(1,0) = Lt_loc(3,0);
-        lay_multi->Dnn(1,1) = Lt_loc(3,3);
-        lay_multi->Dnn(1,2) = Lt_loc(3,4);
-        lay_multi->Dnn(2,0) = Lt_loc(4,0);
-        lay_multi->Dnn(2,1) = Lt_loc(4,3);
-        lay_multi->Dnn(2,2) = Lt_loc(4,4);
+        sv_r = r.sv_global_as<state_variables_M>();
+        lay_multi = r.multi_as<layer_multi>();
+        lay = r.shape_as<layer>();
+        //Dnn and its inverse are only recomputed if the tangent modulus of the layer has changed
+        lay_multi->fillD(sv_r->Lt, *lay);
         
-        mat sigma_local = rotate_g2l_stress(sv_r->sigma, lay->psi_geom, lay->theta_geom, lay->phi_geom);
+        sigma_local = lay_multi->rot_geom.QS_g2l*sv_r->sigma;
         lay_multi->sigma_hat(0) = sigma_local(0);
         lay_multi->sigma_hat(1) = sigma_local(3);
         lay_multi->sigma_hat(2) = sigma_local(4);
-    }
-    
-    for(auto r : phase.sub_phases) {
-        lay_multi = std::dynamic_pointer_cast<layer_multi>(r.sptr_multi);
-        lay = std::dynamic_pointer_cast<layer>(r.sptr_shape);
-        sumDnn += lay->concentration*inv(lay_multi->Dnn);
-        sumcDsig += lay->concentration*inv(lay_multi->Dnn)*lay_multi->sigma_hat;
+        
+        sumDnn += lay->concentration*lay_multi->inv_Dnn;
+        sumcDsig += lay->concentration*lay_multi->inv_Dnn*lay_multi->sigma_hat;
     }
     vec m = inv(sumDnn)*sumcDsig;
     
-    for(auto r : phase.sub_phases) {
+    vec6 dEtot_local;
+    for(auto &r : phase.sub_phases) {
         
-        sv_r = std::dynamic_pointer_cast<state_variables_M>(r.sptr_sv_global);
-        lay_multi = std::dynamic_pointer_cast<layer_multi>(r.sptr_multi);
-        lay_multi->dzdx1 = inv(lay_multi->Dnn)*(m-lay_multi->sigma_hat);
-        lay = std::dynamic_pointer_cast<layer>(r.sptr_shape);
+        sv_r = r.sv_global_as<state_variables_M>();
+        lay_multi = r.multi_as<layer_multi>();
+        lay_multi->dzdx1 = lay_multi->inv_Dnn*(m-lay_multi->sigma_hat);
         
-        mat dEtot_local = zeros(6);
+        dEtot_local.zeros();
         dEtot_local(0) = lay_multi->dzdx1(0);
         dEtot_local(3) = lay_multi->dzdx1(1);
         dEtot_local(4) = lay_multi->dzdx1(2);
-        mat dEtot_global = rotate_l2g_strain(dEtot_local, lay->psi_geom, lay->theta_geom, lay->phi_geom);
         
-        sv_r->DEtot += dEtot_global;
+        sv_r->DEtot += lay_multi->rot_geom.QE_l2g*dEtot_local;
     }
 }
     
 void Lt_Periodic_Layer(phase_characteristics &phase) {
     
-    std::shared_ptr<layer_multi> lay_multi;
-    std::shared_ptr<layer> lay;
+    layer_multi *lay_multi;
+    layer *lay;
     //ptr on the matrix properties
-    std::shared_ptr<state_variables_M> sv_r;
+    state_variables_M *sv_r;
     
-    mat Lt_loc = zeros(6,6);
     mat A_loc = zeros(6,6);
     
     //Compute the strain concentration tensor A
-    for(auto r : phase.sub_phases) {
-        
-        sv_r = std::dynamic_pointer_cast<state_variables_M>(r.sptr_sv_global);
-        lay_multi = std::dynamic_pointer_cast<layer_multi>(r.sptr_multi);
-        lay = std::dynamic_pointer_cast<layer>(r.sptr_shape);
-        Lt_loc = rotate_g2l_L(sv_r->Lt, lay->psi_geom, lay->theta_geom, lay->phi_geom);
-        
-        lay_multi->Dnn(0,0) = Lt_loc(0,0);
-        lay_multi->Dnn(0,1) = Lt_loc(0,3);
-        lay_multi->Dnn(0,2) = Lt_loc(0,4);
-        lay_multi->Dnn(1,0) = Lt_loc(3,0);
-        lay_multi->Dnn(1,1) = Lt_loc(3,3);
-        lay_multi->Dnn(1,2) = Lt_loc(3,4);
-        lay_multi->Dnn(2,0) = Lt_loc(4,0);
-        lay_multi->Dnn(2,1) = Lt_loc(4,3);
-        lay_multi->Dnn(2,2) = Lt_loc(4,4);
-        
-        lay_multi->Dnt(0,0) = Lt_loc(0,1);
-        lay_multi->Dnt(0,1) = Lt_loc(0,2);
-        lay_multi->Dnt(0,2) = Lt_loc(0,5);
-        lay_multi->Dnt(1,0) = Lt_loc(3,1);
-        lay_multi->Dnt(1,1) = Lt_loc(3,2);
-        lay_multi->Dnt(1,2) = Lt_loc(3,5);
-        lay_multi->Dnt(2,0) = Lt_loc(4,1);
-        lay_multi->Dnt(2,1) = Lt_loc(4,2);
-        lay_multi->Dnt(2,2) = Lt_loc(4,5);
-    }
-    
     mat sumDnn = zeros(3,3);
     mat sumDnt = zeros(3,3);
-    for(auto r : phase.sub_phases) {
-        lay_multi = std::dynamic_pointer_cast<layer_multi>(r.sptr_multi);
-        lay = std::dynamic_pointer_cast<layer>(r.sptr_shape);
-        sumDnn += lay->concentration*inv(lay_multi->Dnn);
-        sumDnt += lay->concentration*inv(lay_multi->Dnn)*lay_multi->Dnt;
+    for(auto &r : phase.sub_phases) {
+        
+        sv_r = r.sv_global_as<state_variables_M>();
+        lay_multi = r.multi_as<layer_multi>();
+        lay = r.shape_as<layer>();
+        //Dnn, Dnt and the inverse of Dnn are only recomputed if the tangent modulus of the layer has changed
+        lay_multi->fillD(sv_r->Lt, *lay);
+        
+        sumDnn += lay->concentration*lay_multi->inv_Dnn;
+        sumDnt += lay->concentration*lay_multi->inv_Dnn*lay_multi->Dnt;
     }
     mat m_n = inv(sumDnn);
     mat m_t = m_n*sumDnt;
 
-    for(auto r : phase.sub_phases) {
-        lay_multi = std::dynamic_pointer_cast<layer_multi>(r.sptr_multi);
-        lay = std::dynamic_pointer_cast<layer>(r.sptr_shape);        
-        lay_multi->dXn = inv(lay_multi->Dnn)*(m_n-lay_multi->Dnn);
-        lay_multi->dXt = inv(lay_multi->Dnn)*(m_t-lay_multi->Dnt);
+    for(auto &r : phase.sub_phases) {
+        lay_multi = r.multi_as<layer_multi>();
+        lay_multi->dXn = lay_multi->inv_Dnn*(m_n-lay_multi->Dnn);
+        lay_multi->dXt = lay_multi->inv_Dnn*(m_t-lay_multi->Dnt);
         
         A_loc = eye(6,6);
         
@@ -382,10 +501,62 @@ void Lt_Periodic_Layer(phase_characteristics &phase) {
         A_loc(4,4) += lay_multi->dXn(2,2);
         A_loc(4,5) += lay_multi->dXt(2,2);
 
-        lay_multi->A = rotate_l2g_A(A_loc, lay->psi_geom, lay->theta_geom, lay->phi_geom);
+        lay_multi->A = lay_multi->rot_geom.l2g_A(A_loc);
     }
     
 }
     
     
+void read_scheme_ellipsoids(phase_characteristics &phase) {
+    
+    string path_data = "data";
+    string inputfile = "Nellipsoids" + to_string(int(phase.sptr_matprops->props(1))) + ".dat";
+    read_ellipsoid(phase, path_data, inputfile);
+    
+    //The sub-phases share the table of integration points x,wx,y,wy
+    auto gauss = get_Gauss_points(int(phase.sptr_matprops->props(2)), int(phase.sptr_matprops->props(3)));
+    for (auto &r : phase.sub_phases) {
+        r.multi_as<ellipsoid_multi>()->gauss = gauss;
+    }
+}
+
+void read_scheme_cylinders(phase_characteristics &phase) {
+    
+    string path_data = "data";
+    string inputfile = "Ncylinders" + to_string(int(phase.sptr_matprops->props(1))) + ".dat";
+    read_cylinder(phase, path_data, inputfile);
+}
+
+void read_scheme_layers(phase_characteristics &phase) {
+    
+    string path_data = "data";
+    string inputfile = "Nlayers" + to_string(int(phase.sptr_matprops->props(1))) + ".dat";
+    read_layer(phase, path_data, inputfile);
+}
+    
+void scheme_base::homogenize(phase_characteristics &phase) {
+    
+    state_variables_M *sv_eff = phase.sv_local_as<state_variables_M>();
+    
+    //Compute the effective stress
+    sv_eff->sigma.zeros();
+    for (auto &r : phase.sub_phases) {
+        sv_eff->sigma += r.sptr_shape->concentration*r.sptr_sv_global->sigma;
+    }
+    homogenize_tangent(phase);
+}
+
+void scheme_base::homogenize_tangent(phase_characteristics &phase) {
+    
+    state_variables_M *sv_eff = phase.sv_local_as<state_variables_M>();
+    state_variables_M *sv_r;
+    
+    //Compute the effective tangent modulus
+    sv_eff->Lt.zeros();
+    for (auto &r : phase.sub_phases) {
+        sv_r = r.sv_global_as<state_variables_M>();
+        sv_eff->Lt += r.sptr_shape->concentration*(sv_r->Lt*r.sptr_multi->A);
+    }
+}
+
 } //namespace smart
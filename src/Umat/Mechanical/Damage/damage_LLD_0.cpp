@@ -24,6 +24,7 @@
 #include <smartplus/Libraries/Maths/rotation.hpp>
 #include <smartplus/Libraries/Continuum_Mechanics/contimech.hpp>
 #include <smartplus/Libraries/Continuum_Mechanics/constitutive.hpp>
+#include <smartplus/Libraries/Continuum_Mechanics/voigt.hpp>
 #include <smartplus/Libraries/Maths/num_solve.hpp>
 
 #include <smartplus/Umat/Mechanical/Damage/damage_LLD_0.hpp>
@@ -56,7 +57,7 @@ void umat_damage_LLD_0(const vec &Etot, const vec &DEtot, vec &sigma, mat &Lt, c
     double d_22 = statev(2);
     double p_ts = statev(3);    //Accumulated plasticity
         
-    vec EP(6);
+    vec6 EP;
     EP(0) = statev(4);
     EP(1) = statev(5);
     EP(2) = statev(6);
@@ -78,8 +79,8 @@ void umat_damage_LLD_0(const vec &Etot, const vec &DEtot, vec &sigma, mat &Lt, c
         sigma = zeros(6);
     }
     
-    vec sigma_start = sigma;
-    vec EP_start = EP;
+    vec6 sigma_start = sigma;
+    vec6 EP_start = EP;
     
     double EL = props(0);
     double ET = props(1);
@@ -126,20 +127,21 @@ void umat_damage_LLD_0(const vec &Etot, const vec &DEtot, vec &sigma, mat &Lt, c
     
     // ######################  Elastic stiffness #################################
     //defines L
-    mat L = L_isotrans(EL, ET, nuTL, nuTT, GLT, 1);
+    mat66 L;
+    L_isotrans(L, EL, ET, nuTL, nuTT, GLT, 1);
     
     //definition of the CTE tensor
-    vec alpha = zeros(6);
+    vec6 alpha = zeros(6);
     alpha = alphaT*Ith();
     alpha(0) += alphaL-alphaT;                              //WARNING CTE tensor is defined according to L is the direction 1
     
     //Compute the elastic strain and the related stress
-    vec Eel_start = Etot - alpha*(T-Tinit) - EP;
-    vec DEel_start = DEtot - alpha*DT;
-    vec Eel = Eel_start + DEel_start;
+    vec6 Eel_start = Etot - alpha*(T-Tinit) - EP;
+    vec6 DEel_start = DEtot - alpha*DT;
+    vec6 Eel = Eel_start + DEel_start;
     
-    vec sigma_eff = zeros(6);
-    vec sigma_eff_ts = zeros(6);
+    vec6 sigma_eff = zeros(6);
+    vec6 sigma_eff_ts = zeros(6);
     
     ///Compute the Yd_12 and Yd_22 which are the criterium associated with damage
     double Yd_12 = 0.;
@@ -158,7 +160,7 @@ void umat_damage_LLD_0(const vec &Etot, const vec &DEtot, vec &sigma, mat &Lt, c
     
     //Compute the Plasticity functions
     //Compute the explicit flow direction
-    vec Lambdap_ts = zeros(6);
+    vec6 Lambdap_ts = zeros(6);
     
     //Define the plastic function and the stress
     double Hp_ts = 0.;
@@ -166,7 +168,7 @@ void umat_damage_LLD_0(const vec &Etot, const vec &DEtot, vec &sigma, mat &Lt, c
     double Phi_p_ts = 0.;
 
     double dPhi_p_tsd_p = 0.;
-    vec dPhi_p_tsd_sigma = zeros(6);
+    vec6 dPhi_p_tsd_sigma = zeros(6);
     
     //Note : The sup function are not required here, since we utilize Kuhn-Tucker conditions instead (dD >= 0)
     vec Phi_d = zeros(2);
@@ -193,7 +195,7 @@ void umat_damage_LLD_0(const vec &Etot, const vec &DEtot, vec &sigma, mat &Lt, c
     int compteur = 0;
     double error = 1.;
     
-    mat Theta_ts = zeros(6,6);
+    mat66 Theta_ts = zeros(6,6);
     Theta_ts(1,1) = A_ts;
     Theta_ts(2,2) = A_ts;
     Theta_ts(3,3) = 1.;
@@ -272,25 +274,27 @@ void umat_damage_LLD_0(const vec &Etot, const vec &DEtot, vec &sigma, mat &Lt, c
     double dY12_d_s12 = 0.;
     double dY13_d_s13 = 0.;
     
-    vec dPhi_d_22d_sigma = zeros(6);
-    vec dPhi_d_12d_sigma = zeros(6);
+    vec6 dPhi_d_22d_sigma = zeros(6);
+    vec6 dPhi_d_12d_sigma = zeros(6);
     
     double dPhi_d_12d_12 = 0.;
     double dPhi_d_12d_22 = 0.;
     double dPhi_d_22d_12 = 0.;
     double dPhi_d_22d_22 = 0.;
     
-    mat dStildedd22 = zeros(6,6);
-    mat dStildedd12 = zeros(6,6);
+    mat66 dStildedd22 = zeros(6,6);
+    mat66 dStildedd12 = zeros(6,6);
     
-    vec Lambdad_22 = zeros(6);
-    vec Lambdad_12 = zeros(6);
+    vec6 Lambdad_22 = zeros(6);
+    vec6 Lambdad_12 = zeros(6);
+    
+    mat66 L_tilde;
     
     
     //So it is forced to enter the damage loop once
     for (compteur = 0; ((compteur < maxiter_umat) && (error > precision_umat)); compteur++) {
         
-        mat L_tilde = L_ortho(E1,E2,E3,nu12,nu13,nu23,G12,G13,G23, "EnuG");
+        L_ortho(L_tilde, E1,E2,E3,nu12,nu13,nu23,G12,G13,G23, "EnuG");
         
         //damaged modulus
         //Compute the elastic strain and the related stress
@@ -417,19 +421,15 @@ void umat_damage_LLD_0(const vec &Etot, const vec &DEtot, vec &sigma, mat &Lt, c
         dPhi_d_12d_sigma(5) = 0.;
         
         //Compute the explicit "damage direction" and flow direction
-        dStildedd22 = { {0.,0.,0.,0.,0.,0.},
-            {0,E2_0/pow(E2,2.),-nu23*E2_0/pow(E2,2.),0,0,0},
-            {0,-nu23*E2_0/pow(E2,2.),E2_0/pow(E2,2.),0,0,0},
-            {0,0,0,0,0,0},
-            {0,0,0,0,0,0},
-            {0,0,0,0,0,0} };
-        
-        dStildedd12 = { {0,0,0,0,0,0},
-            {0,0,0,0,0,0},
-            {0,0,0,0,0,0},
-            {0,0,0,G12_0/pow(G12,2.),0,0},
-            {0,0,0,0,G12_0/pow(G12,2.),0},
-            {0,0,0,0,0,0} };
+        dStildedd22.zeros();
+        dStildedd22(1,1) = E2_0/pow(E2,2.);
+        dStildedd22(1,2) = -nu23*E2_0/pow(E2,2.);
+        dStildedd22(2,1) = -nu23*E2_0/pow(E2,2.);
+        dStildedd22(2,2) = E2_0/pow(E2,2.);
+        
+        dStildedd12.zeros();
+        dStildedd12(3,3) = G12_0/pow(G12,2.);
+        dStildedd12(4,4) = G12_0/pow(G12,2.);
 
         Lambdad_22 = dStildedd22*sigma;
         Lambdad_12 = dStildedd12*sigma;
@@ -472,7 +472,7 @@ void umat_damage_LLD_0(const vec &Etot, const vec &DEtot, vec &sigma, mat &Lt, c
     G12 = G12_0*(1.-d_12);
     G13 = G12_0*(1.-d_12);
     
-    mat L_tilde = L_ortho(E1,E2,E3,nu12,nu13,nu23,G12,G13,G23, "EnuG");
+    L_ortho(L_tilde, E1,E2,E3,nu12,nu13,nu23,G12,G13,G23, "EnuG");
     
     //damaged modulus
     //Compute the elastic strain and the related stress
@@ -500,7 +500,7 @@ void umat_damage_LLD_0(const vec &Etot, const vec &DEtot, vec &sigma, mat &Lt, c
     else
         sigma = L_tilde*Eel;
 
-    mat B = L*inv(L_tilde);         //stress "localization factor" in damage
+    mat66 B = L*inv(L_tilde);         //stress "localization factor" in damage
     
     //Compute the derivatives
     dPhi_d_22d_Yts = 1./Y_22_c;
@@ -546,29 +546,25 @@ void umat_damage_LLD_0(const vec &Etot, const vec &DEtot, vec &sigma, mat &Lt, c
     dPhi_p_tsd_sigma = (B*Theta_ts*eta_stress(sigma_eff_ts))%Ir05();
     
     //Compute the explicit "damage direction" and flow direction
-    dStildedd22 = { {0.,0.,0.,0.,0.,0.},
-                        {0,E2_0/pow(E2,2.),-nu23*E2_0/pow(E2,2.),0,0,0},
-                        {0,-nu23*E2_0/pow(E2,2.),E2_0/pow(E2,2.),0,0,0},
-                        {0,0,0,0,0,0},
-                        {0,0,0,0,0,0},
-                        {0,0,0,0,0,0} };
-    
-    dStildedd12 = { {0,0,0,0,0,0},
-                        {0,0,0,0,0,0},
-                        {0,0,0,0,0,0},
-                        {0,0,0,G12_0/pow(G12,2.),0,0},
-                        {0,0,0,0,G12_0/pow(G12,2.),0},
-                        {0,0,0,0,0,0} };
+    dStildedd22.zeros();
+    dStildedd22(1,1) = E2_0/pow(E2,2.);
+    dStildedd22(1,2) = -nu23*E2_0/pow(E2,2.);
+    dStildedd22(2,1) = -nu23*E2_0/pow(E2,2.);
+    dStildedd22(2,2) = E2_0/pow(E2,2.);
+    
+    dStildedd12.zeros();
+    dStildedd12(3,3) = G12_0/pow(G12,2.);
+    dStildedd12(4,4) = G12_0/pow(G12,2.);
     
     Lambdap_ts = Theta_ts*eta_stress(sigma_eff_ts);
 
-    vec kappamat0 = zeros(6);
+    vec6 kappamat0 = zeros(6);
     kappamat0 = (dStildedd22*sigma)%Ir05();
 
-    vec kappamat1 = zeros(6);
+    vec6 kappamat1 = zeros(6);
     kappamat1 = (dStildedd12*sigma)%Ir05();
     
-    vec kappamat2 = zeros(6);
+    vec6 kappamat2 = zeros(6);
     kappamat2 = (Lambdap_ts)%Ir05();
     
     mat Bhat = zeros(3, 3);
@@ -610,14 +606,22 @@ void umat_damage_LLD_0(const vec &Etot, const vec &DEtot, vec &sigma, mat &Lt, c
         }
     }
     
-    vec Pjay0 = zeros(6);
+    vec6 Pjay0 = zeros(6);
     Pjay0 = L_tilde*(invBhat(0, 0)*dPhi_d_22d_sigma + invBhat(1, 0)*dPhi_d_12d_sigma + invBhat(2, 0)*dPhi_p_tsd_sigma);
-    vec Pjay1 = zeros(6);
+    vec6 Pjay1 = zeros(6);
     Pjay1 = L_tilde*(invBhat(0, 1)*dPhi_d_22d_sigma + invBhat(1, 1)*dPhi_d_12d_sigma + invBhat(2, 1)*dPhi_p_tsd_sigma);
-    vec Pjay2 = zeros(6);
+    vec6 Pjay2 = zeros(6);
     Pjay2 = L_tilde*(invBhat(0, 2)*dPhi_d_22d_sigma + invBhat(1, 2)*dPhi_d_12d_sigma + invBhat(2, 2)*dPhi_p_tsd_sigma);
     
-    Lt = L_tilde + L_tilde*(kappamat0*trans(Pjay0) + kappamat1*trans(Pjay1) + kappamat2*trans(Pjay2));
+    //Lt = L_tilde + L_tilde*(kappamat0*trans(Pjay0) + kappamat1*trans(Pjay1) + kappamat2*trans(Pjay2)), without the temporary outer products
+    mat66 kappaPjay;
+    for (int i=0; i<6; i++) {
+        for (int j=0; j<6; j++) {
+            kappaPjay(i,j) = kappamat0(i)*Pjay0(j) + kappamat1(i)*Pjay1(j) + kappamat2(i)*Pjay2(j);
+        }
+    }
+    Lt = L_tilde*kappaPjay;
+    Lt += L_tilde;
 
 /*    if (Y_t > Y_22_u) {
         Lt = L_iso(1, 0.3, "Enu");
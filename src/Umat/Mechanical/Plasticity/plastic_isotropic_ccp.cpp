@@ -27,6 +27,7 @@
 #include <smartplus/parameter.hpp>
 #include <smartplus/Libraries/Continuum_Mechanics/contimech.hpp>
 #include <smartplus/Libraries/Continuum_Mechanics/constitutive.hpp>
+#include <smartplus/Libraries/Continuum_Mechanics/voigt.hpp>
 #include <smartplus/Libraries/Maths/rotation.hpp>
 #include <smartplus/Libraries/Maths/num_solve.hpp>
 
@@ -98,18 +99,20 @@ void umat_plasticity_iso_CCP(const vec &Etot, const vec &DEtot, vec &sigma, mat
     double m=props(5);
     
     //definition of the CTE tensor
-    vec alpha = alpha_iso*Ith();
+    vec6 alpha = alpha_iso*Ith();
     
     // ######################  Elastic compliance and stiffness #################################
     //defines L
-    mat L = L_iso(E, nu, "Enu");
-    mat M = M_iso(E, nu, "Enu");
+    mat66 L;
+    mat66 M;
+    L_iso(L, E, nu, "Enu");
+    M_iso(M, E, nu, "Enu");
     
     ///@brief Temperature initialization
     double T_init = statev(0);
     //From the statev to the internal variables
     double p = statev(1);
-    vec EP(6);
+    vec6 EP;
     EP(0) = statev(2);
     EP(1) = statev(3);
     EP(2) = statev(4);
@@ -124,7 +127,7 @@ void umat_plasticity_iso_CCP(const vec &Etot, const vec &DEtot, vec &sigma, mat
     if(start)
     {
         T_init = T;
-        vec vide = zeros(6);
+        vec6 vide = zeros(6);
         sigma = vide;
         EP = vide;
         p = 0.;
@@ -148,8 +151,8 @@ void umat_plasticity_iso_CCP(const vec &Etot, const vec &DEtot, vec &sigma, mat
     }
     
     //Variables values at the start of the increment
-    vec sigma_start = sigma;
-    vec EP_start = EP;
+    vec6 sigma_start = sigma;
+    vec6 EP_start = EP;
     double A_p_start = -Hp;
     
     //Variables required for the loop
@@ -159,7 +162,7 @@ void umat_plasticity_iso_CCP(const vec &Etot, const vec &DEtot, vec &sigma, mat
     vec ds_j = zeros(1);
     
     ///Elastic prediction - Accounting for the thermal prediction
-    vec Eel = Etot + DEtot - alpha*(T+DT-T_init) - EP;
+    vec6 Eel = Etot + DEtot - alpha*(T+DT-T_init) - EP;
     if (ndi == 1) {
         sigma(0) = E*Eel(0);
     }
@@ -177,12 +180,13 @@ void umat_plasticity_iso_CCP(const vec &Etot, const vec &DEtot, vec &sigma, mat
     vec Y_crit = zeros(1);
     
     double dPhidp=0.;
-    vec dPhidsigma = zeros(6);
+    vec6 dPhidsigma = zeros(6);
     double dPhidtheta = 0.;
     
     //Compute the explicit flow direction
-    vec Lambdap = eta_stress(sigma);
-    std::vector<vec> kappa_j(1);
+    vec6 Lambdap;
+    eta_stress(sigma, Lambdap);
+    vec6 kappa_j[1];
     kappa_j[0] = L*Lambdap;
     mat K = zeros(1,1);
     
@@ -202,13 +206,13 @@ void umat_plasticity_iso_CCP(const vec &Etot, const vec &DEtot, vec &sigma, mat
             dHpdp = 0.;
             Hp = 0.;
         }
-        dPhidsigma = eta_stress(sigma);
+        eta_stress(sigma, dPhidsigma);
         dPhidp = -1.*dHpdp;
         
         //compute Phi and the derivatives
         Phi(0) = Mises_stress(sigma) - Hp - sigmaY;
         
-        Lambdap = eta_stress(sigma);
+        eta_stress(sigma, Lambdap);
         kappa_j[0] = L*Lambdap;
         
         K(0,0) = dPhidp;
@@ -236,8 +240,8 @@ void umat_plasticity_iso_CCP(const vec &Etot, const vec &DEtot, vec &sigma, mat
     }
     
     //Computation of the increments of variables
-    vec Dsigma = sigma - sigma_start;
-    vec DEP = EP - EP_start;
+    vec6 Dsigma = sigma - sigma_start;
+    vec6 DEP = EP - EP_start;
     double Dp = Ds_j[0];
     
     //Computation of the tangent modulus
@@ -268,12 +272,17 @@ void umat_plasticity_iso_CCP(const vec &Etot, const vec &DEtot, vec &sigma, mat
         }
     }
     
-    std::vector<vec> P_epsilon(1);
+    vec6 P_epsilon[1];
     P_epsilon[0] = invBhat(0, 0)*(L*dPhidsigma);
-    std::vector<double> P_theta(1);
+    double P_theta[1];
     P_theta[0] = dPhidtheta - sum(dPhidsigma%(L*alpha));
     
-    Lt = L - (kappa_j[0]*P_epsilon[0].t());
+    //Lt = L - kappa_j[0]*P_epsilon[0].t(), without the temporary outer product
+    for (int i=0; i<6; i++) {
+        for (int j=0; j<6; j++) {
+            Lt(i,j) = L(i,j) - kappa_j[0](i)*P_epsilon[0](j);
+        }
+    }
 
     double A_p = -Hp;        
     double Dgamma_loc = 0.5*sum((sigma_start+sigma)%DEP) + 0.5*(A_p_start + A_p)*Dp;
@@ -29,6 +29,7 @@
 #include <smartplus/Libraries/Maths/rotation.hpp>
 #include <smartplus/Libraries/Continuum_Mechanics/contimech.hpp>
 #include <smartplus/Libraries/Continuum_Mechanics/constitutive.hpp>
+#include <smartplus/Libraries/Continuum_Mechanics/voigt.hpp>
 #include <smartplus/Libraries/Continuum_Mechanics/recovery_props.hpp>
 
 #include <smartplus/Libraries/Maths/num_solve.hpp>
@@ -138,7 +139,7 @@ void umat_sma_unified_T(const vec &Etot, const vec &DEtot, vec &sigma, mat &Lt,
     ///@brief Martensite volume fraction initialization
     double xi = statev(1);
     ///@brief mean strain tensor creation
-    vec ET = zeros(6);
+    vec6 ET = zeros(6);
     ET(0) = statev(2);
     ET(1) = statev(3);
     ET(2) = statev(4);
@@ -147,9 +148,9 @@ void umat_sma_unified_T(const vec &Etot, const vec &DEtot, vec &sigma, mat &Lt,
     ET(5) = statev(7);
     
     ///@brief ETMax allow the definition of the lambdaTR
-    vec DETF = zeros(6);
-    vec DETR = zeros(6);
-    vec ETMean = zeros(6);
+    vec6 DETF = zeros(6);
+    vec6 DETR = zeros(6);
+    vec6 ETMean = zeros(6);
 
     double xiF = statev(8);
     double xiR = statev(9);
@@ -175,25 +176,29 @@ void umat_sma_unified_T(const vec &Etot, const vec &DEtot, vec &sigma, mat &Lt,
     double mu_eff = (mu_A*mu_M)/(xi*mu_A + (1. - xi)*mu_M);
     
     //defines M_A and M_M
-    mat M_A = M_iso(K_A, mu_A, "Kmu");
-    mat M_M = M_iso(K_M, mu_M, "Kmu");
-    mat M = M_iso(K_eff, mu_eff, "Kmu");
-    mat L = L_iso(K_eff, mu_eff, "Kmu");
+    mat66 M_A;
+    mat66 M_M;
+    mat66 M;
+    mat66 L;
+    M_iso(M_A, K_A, mu_A, "Kmu");
+    M_iso(M_M, K_M, mu_M, "Kmu");
+    M_iso(M, K_eff, mu_eff, "Kmu");
+    L_iso(L, K_eff, mu_eff, "Kmu");
     vec el_props = L_iso_props(L);
     double E = el_props(0);
     double nu = el_props(1);
     
-    mat DM = M_M - M_A;
+    mat66 DM = M_M - M_A;
     
     //definition of the CTE tensor
-    vec alpha = (alphaM_iso*xi + alphaA_iso*(1.-xi))*Ith();
-    vec Dalpha = (alphaM_iso - alphaA_iso)*Ith();
+    vec6 alpha = (alphaM_iso*xi + alphaA_iso*(1.-xi))*Ith();
+    vec6 Dalpha = (alphaM_iso - alphaA_iso)*Ith();
 
     ///@brief Initialization
     if(start) {
         
         T_init = T;
-        vec vide = zeros(6);
+        vec6 vide = zeros(6);
         sigma = zeros(6);
         ET = zeros(6);
         xiF = limit;
@@ -247,8 +252,8 @@ void umat_sma_unified_T(const vec &Etot, const vec &DEtot, vec &sigma, mat &Lt,
     rotate_strain(ET, DR);
 
     //Variables values at the start of the increment
-    vec	sigma_start = sigma;
-    vec ET_start = ET;
+    vec6 sigma_start = sigma;
+    vec6 ET_start = ET;
     
     // Find Hcur explicit
     if (Mises_stress(sigma) > sigmacrit)
@@ -259,7 +264,7 @@ void umat_sma_unified_T(const vec &Etot, const vec &DEtot, vec &sigma, mat &Lt,
     double Hcur = Hmin + (Hmax - Hmin)*(1. - exp(-1.*k1*sigmastar));
     
     //definition of Lambdas associated to transformation
-    vec lambdaTF = Hcur*dPrager_stress(sigma, prager_b, prager_n);
+    vec6 lambdaTF = Hcur*dPrager_stress(sigma, prager_b, prager_n);
     
     if (Mises_strain(ET) > 1E-6)
         ETMean = dev(ET) / (xi);
@@ -268,7 +273,7 @@ void umat_sma_unified_T(const vec &Etot, const vec &DEtot, vec &sigma, mat &Lt,
     else
         ETMean = 0.*Ith();
     
-    vec lambdaTR = -1.*ETMean;
+    vec6 lambdaTR = -1.*ETMean;
     
     //Definition of the modified Y function
     double YtF = Y0t + D*Hcur*Mises_stress(sigma);
@@ -300,9 +305,9 @@ void umat_sma_unified_T(const vec &Etot, const vec &DEtot, vec &sigma, mat &Lt,
     double lambda1 = lagrange_pow_1(xi, c_lambda, p0_lambda, n_lambda, alpha_lambda);
     
     //Define the value of DM_sig
-    vec DM_sig = (DM*sigma_start);
+    vec6 DM_sig = (DM*sigma_start);
     //Define the value of DM_sig
-    vec Dalpha_sig = (Dalpha%sigma_start);
+    vec6 Dalpha_sig = (Dalpha%sigma_start);
     
     //Set the thermo forces
     double A_xiF = rhoDs0*(T+DT) - rhoDE0 + 0.5*sum(sigma%DM_sig) + sum(sigma%Dalpha)*(T+DT) - HfF;
@@ -322,7 +327,7 @@ void umat_sma_unified_T(const vec &Etot, const vec &DEtot, vec &sigma, mat &Lt,
     vec ds_j = zeros(2);
 
     ///Elastic prediction - Accounting for the thermal prediction
-    vec Eel = Etot + DEtot - alpha*(T+DT-T_init) - ET;
+    vec6 Eel = Etot + DEtot - alpha*(T+DT-T_init) - ET;
     if (ndi == 1) {
         sigma(0) = E*Eel(0);
     }
@@ -342,57 +347,57 @@ void umat_sma_unified_T(const vec &Etot, const vec &DEtot, vec &sigma, mat &Lt,
     //Define the function for the system to solve
     double dHfF = 0.;
     double dHfR = 0.;
-    vec dHcurdsigma = zeros(6);
+    vec6 dHcurdsigma = zeros(6);
     //Relative to forward transformation
-    vec dPhihatFdsigma = zeros(6);
+    vec6 dPhihatFdsigma = zeros(6);
     double dPhihatFdxiF = 0.;
     double dPhihatFdxiR = 0.;
 
-    vec dA_xiFdsigma = zeros(6);
+    vec6 dA_xiFdsigma = zeros(6);
     double dA_xiFdxiF = 0.;
     double dA_xiFdxiR = 0.;
 
-    vec dlambda1dsigma = zeros(6);
+    vec6 dlambda1dsigma = zeros(6);
     double dlambda1dxiF = 0.;
     double dlambda1dxiR = 0.;
 
-    vec dYtFdsigma = zeros(6);
+    vec6 dYtFdsigma = zeros(6);
     double dYtFdxiF = 0.;
     double dYtFdxiR = 0.;
     
-    vec dPhiFdsigma = zeros(6);
+    vec6 dPhiFdsigma = zeros(6);
     double dPhiFdxiF = 0.;
     double dPhiFdxiR = 0.;
     
     //Relative to reverse transformation
-    vec dPhihatRdsigma = zeros(6);
+    vec6 dPhihatRdsigma = zeros(6);
     double dPhihatRdxiF = 0.;
     double dPhihatRdxiR = 0.;
-    vec dPhihatRdETF = zeros(6);
-    vec dPhihatRdETR = zeros(6);
+    vec6 dPhihatRdETF = zeros(6);
+    vec6 dPhihatRdETR = zeros(6);
     
-    vec dA_xiRdsigma = zeros(6);
+    vec6 dA_xiRdsigma = zeros(6);
     double dA_xiRdxiF = 0.;
     double dA_xiRdxiR = 0.;
     
-    vec dlambda0dsigma = zeros(6);
+    vec6 dlambda0dsigma = zeros(6);
     double dlambda0dxiF = 0.;
     double dlambda0dxiR = 0.;
     
-    vec dYtRdsigma = zeros(6);
+    vec6 dYtRdsigma = zeros(6);
     double dYtRdxiF = 0.;
     double dYtRdxiR = 0.;
-    vec dYtRdETF = zeros(6);
-    vec dYtRdETR = zeros(6);
+    vec6 dYtRdETF = zeros(6);
+    vec6 dYtRdETR = zeros(6);
     
-    vec dPhiRdsigma = zeros(6);
+    vec6 dPhiRdsigma = zeros(6);
     double dPhiRdxiF = 0.;
     double dPhiRdxiR = 0.;
-    vec dPhiRdETF = zeros(6);
-    vec dPhiRdETR = zeros(6);
+    vec6 dPhiRdETF = zeros(6);
+    vec6 dPhiRdETR = zeros(6);
     
     //Compute the explicit flow direction
-    std::vector<vec> kappa_j(2);
+    vec6 kappa_j[2];
     mat K = zeros(2,2);
     
     //Loop parameters
@@ -416,8 +421,8 @@ void umat_sma_unified_T(const vec &Etot, const vec &DEtot, vec &sigma, mat &Lt,
         
         K_eff = (K_A*K_M) / (xi*K_A + (1. - xi)*K_M);
         mu_eff = (mu_A*mu_M) / (xi*mu_A + (1. - xi)*mu_M);
-        L = L_iso(K_eff, mu_eff, "Kmu");
-        M = M_iso(K_eff, mu_eff, "Kmu");
+        L_iso(L, K_eff, mu_eff, "Kmu");
+        M_iso(M, K_eff, mu_eff, "Kmu");
         
         DM_sig = DM*sigma;
         Dalpha_sig = Dalpha%sigma;
@@ -594,8 +599,8 @@ void umat_sma_unified_T(const vec &Etot, const vec &DEtot, vec &sigma, mat &Lt,
     }
 
     //Computation of the increments of variables
-    vec Dsigma = sigma - sigma_start;
-    vec DET = ET - ET_start;
+    vec6 Dsigma = sigma - sigma_start;
+    vec6 DET = ET - ET_start;
     double DxiF = Ds_j[0];
     double DxiR = Ds_j[1];
     
@@ -630,11 +635,17 @@ void umat_sma_unified_T(const vec &Etot, const vec &DEtot, vec &sigma, mat &Lt,
         }
     }
     
-    std::vector<vec> P_epsilon(2);
-    P_epsilon[0] = invBhat(0, 0)*(L*dPhiFdsigma) + invBhat(0, 1)*(L*dPhiRdsigma);
-    P_epsilon[1] = invBhat(1, 0)*(L*dPhiFdsigma) + invBhat(1, 1)*(L*dPhiRdsigma);
+    vec6 LdPhiFdsigma = L*dPhiFdsigma;
+    vec6 LdPhiRdsigma = L*dPhiRdsigma;
+    vec6 P_epsilon[2];
+    P_epsilon[0] = invBhat(0, 0)*LdPhiFdsigma + invBhat(0, 1)*LdPhiRdsigma;
+    P_epsilon[1] = invBhat(1, 0)*LdPhiFdsigma + invBhat(1, 1)*LdPhiRdsigma;
     
-    Lt = L - (kappa_j[0]*P_epsilon[0].t() + kappa_j[1]*P_epsilon[1].t());
+    for (int i=0; i<6; i++) {
+        for (int j=0; j<6; j++) {
+            Lt(i,j) = L(i,j) - (kappa_j[0](i)*P_epsilon[0](j) + kappa_j[1](i)*P_epsilon[1](j));
+        }
+    }
     
     //Preliminaries for the computation of mechanical work
     
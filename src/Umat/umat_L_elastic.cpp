@@ -20,13 +20,13 @@
 ///@version 0.9
 
 #include <iostream>
-#include <map>
 #include <assert.h>
 #include <string.h>
 #include <math.h>
 #include <armadillo>
 #include <smartplus/parameter.hpp>
 #include <smartplus/Umat/umat_L_elastic.hpp>
+#include <smartplus/Umat/umat_registry.hpp>
 #include <smartplus/Libraries/Continuum_Mechanics/constitutive.hpp>
 #include <smartplus/Libraries/Phase/phase_characteristics.hpp>
 #include <smartplus/Libraries/Phase/state_variables_M.hpp>
@@ -34,6 +34,7 @@
 #include <smartplus/Libraries/Homogenization/ellipsoid_multi.hpp>
 #include <smartplus/Libraries/Homogenization/eshelby.hpp>
 #include <smartplus/Micromechanics/schemes.hpp>
+#include <smartplus/Micromechanics/multiphase.hpp>
 
 
 using namespace std;
@@ -43,41 +44,20 @@ namespace smart{
     
 void get_L_elastic(phase_characteristics &rve)
 {
-    string path_data = "data";
-    string inputfile; //file # that stores the microstructure properties
+    if (rve.sptr_matprops->umat_id == umat_unknown)
+        rve.sptr_matprops->umat_id = find_umat(rve.sptr_matprops->umat_name);
     
-    std::map<string, int> list_umat;
-    list_umat = {{"ELISO",1},{"ELIST",2},{"ELORT",3},{"MIHEN",100},{"MIMTN",101},{"MISCN",102},{"MIPCW",103},{"MIPLN",104}};
+    int method = rve.sptr_matprops->umat_id;
     
-    int method = list_umat[rve.sptr_matprops->umat_name];
-    
-    //first we read the behavior of the phases & we construct the tensors if necessary
-    switch (method) {
-            
-        case 100: case 101: case 102: case 103: {
-            //Definition of the static vectors x,wx,y,wy
-            ellipsoid_multi::mp = rve.sptr_matprops->props(2);
-            ellipsoid_multi::np = rve.sptr_matprops->props(3);
-            ellipsoid_multi::x.set_size(ellipsoid_multi::mp);
-            ellipsoid_multi::wx.set_size(ellipsoid_multi::mp);
-            ellipsoid_multi::y.set_size(ellipsoid_multi::np);
-            ellipsoid_multi::wy.set_size(ellipsoid_multi::np);
-            points(ellipsoid_multi::x, ellipsoid_multi::wx, ellipsoid_multi::y, ellipsoid_multi::wy,ellipsoid_multi::mp, ellipsoid_multi::np);
-            
-            inputfile = "Nellipsoids" + to_string(int(rve.sptr_matprops->props(1))) + ".dat";
-            read_ellipsoid(rve, path_data, inputfile);
-            break;
-        }
-        case 104: {
-            inputfile = "Nlayers" + to_string(int(rve.sptr_matprops->props(1))) + ".dat";
-            read_layer(rve, path_data, inputfile);
-            break;
-        }
+    //Multiphase materials: the scheme is found once from the law id
+    const multiphase_scheme *scheme = find_scheme(method);
+    if (scheme != NULL) {
+        scheme->L_elastic(rve);
+        return;
     }
     
     rve.global2local();
-    auto umat_M = std::dynamic_pointer_cast<state_variables_M>(rve.sptr_sv_local);
-    shared_ptr<state_variables_M> umat_sub_phases_M; //shared_ptr on state variables
+    auto umat_M = rve.sv_local_as<state_variables_M>();
     
     switch (method) {
             
@@ -113,75 +93,12 @@ void get_L_elastic(phase_characteristics &rve)
             umat_M->Lt = L_ortho(Ex,Ey,Ez,nuxy,nuxz,nuyz,Gxy,Gxz,Gyz, "EnuG");
             break;
         }
-        case 100: {
-             for (auto r : rve.sub_phases) {
-                get_L_elastic(r);
-            }
-            Lt_Homogeneous_E(rve);
-            break;
-        }
-        case 101: {
-            for (auto r : rve.sub_phases) {
-                get_L_elastic(r);
-            }
-            int n_matrix = rve.sptr_matprops->props(4);
-            Lt_Mori_Tanaka(rve, n_matrix);
-            break;
-        }
-        case 102: {
-            for (auto r : rve.sub_phases) {
-                get_L_elastic(r);
-            }
-            int n_matrix = rve.sptr_matprops->props(4);
-            Lt_Self_Consistent(rve, n_matrix, true, 1);
-            
-            mat Lt_n = zeros(6,6);
-            int nbiter=0;
-            double error = 1.;
-            
-            while ((error > precision_micro)&&(nbiter <= maxiter_micro)) {
-                Lt_n = umat_M->Lt;
-                for (auto r : rve.sub_phases) {
-                    get_L_elastic(r);
-                }
-                Lt_Self_Consistent(rve, n_matrix, false, 1);
-                umat_M->Lt = zeros(6,6);
-                for (auto r : rve.sub_phases) {
-                    umat_sub_phases_M = std::dynamic_pointer_cast<state_variables_M>(r.sptr_sv_global);
-                    umat_M->Lt += r.sptr_shape->concentration*(umat_sub_phases_M->Lt*r.sptr_multi->A);
-                }
-                error = norm(umat_M->Lt - Lt_n,2.);
-                nbiter++;
-            }
-            break;
-        }
-        case 104: {
-            for (auto r : rve.sub_phases) {
-                get_L_elastic(r);
-            }
-            Lt_Periodic_Layer(rve);
-            break;
-        }
         default: {
             cout << "Error: The choice of Cnstitutive model is not purely linear elastic or could not be found in the umat library :" << rve.sptr_matprops->umat_name << "\n";
             return;
         }
     }
 
-    switch (method) {
-            
-        case 100: case 101: case 102: case 103: case 104: {
-    
-            // Compute the effective tangent modulus, and the effective stress
-            umat_M->Lt = zeros(6,6);
-            for (auto r : rve.sub_phases) {
-                umat_sub_phases_M = std::dynamic_pointer_cast<state_variables_M>(r.sptr_sv_global);
-                umat_M->Lt += r.sptr_shape->concentration*(umat_sub_phases_M->Lt*r.sptr_multi->A);
-            }
-            break;
-        }
-        default: break;
-    }
     rve.local2global();
     
 }
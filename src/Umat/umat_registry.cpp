@@ -0,0 +1,111 @@
+/* This file is part of SMART+.
+ 
+ SMART+ is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ SMART+ is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with SMART+.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+
+///@file umat_registry.cpp
+///@brief Registry of the constitutive laws: resolution of the five-letter umat codes to an integer id and to the functions that implement them
+///@version 1.0
+
+#include <iostream>
+#include <map>
+#include <string>
+#include <armadillo>
+#include <smartplus/Umat/umat_registry.hpp>
+
+#include <smartplus/Umat/Mechanical/Elasticity/elastic_isotropic.hpp>
+#include <smartplus/Umat/Mechanical/Elasticity/elastic_transverse_isotropic.hpp>
+#include <smartplus/Umat/Mechanical/Elasticity/elastic_orthotropic.hpp>
+#include <smartplus/Umat/Mechanical/Plasticity/plastic_isotropic_ccp.hpp>
+#include <smartplus/Umat/Mechanical/Plasticity/plastic_kin_iso_ccp.hpp>
+#include <smartplus/Umat/Mechanical/SMA/unified_T.hpp>
+#include <smartplus/Umat/Mechanical/Damage/damage_LLD_0.hpp>
+
+#include <smartplus/Umat/Thermomechanical/Elasticity/elastic_isotropic.hpp>
+#include <smartplus/Umat/Thermomechanical/Plasticity/plastic_isotropic_ccp.hpp>
+#include <smartplus/Umat/Thermomechanical/Plasticity/plastic_kin_iso_ccp.hpp>
+#include <smartplus/Umat/Thermomechanical/SMA/unified_T.hpp>
+
+using namespace std;
+using namespace arma;
+
+namespace smart{
+
+struct umat_entry {
+    umat_M_function umat_M;
+    umat_T_function umat_T;
+};
+
+//Names of the constitutive laws and their id. The ids of the built-in laws are the historical codes used by umat_multi
+std::map<string, int>& umat_names()
+{
+    static std::map<string, int> list_umat = {{"ELISO",1},{"ELIST",2},{"ELORT",3},{"EPICP",4},{"EPKCP",5},{"SMAUT",6},{"LLDM0",7},{"MIHEN",100},{"MIMTN",101},{"MISCN",102},{"MIPCW",103},{"MIPLN",104}};
+    return list_umat;
+}
+
+//Implementations of the constitutive laws, sorted by id
+std::map<int, umat_entry>& umat_functions()
+{
+    static std::map<int, umat_entry> list_functions = {
+        {1, {umat_elasticity_iso, umat_elasticity_iso_T}},
+        {2, {umat_elasticity_trans_iso, NULL}},
+        {3, {umat_elasticity_ortho, NULL}},
+        {4, {umat_plasticity_iso_CCP, umat_plasticity_iso_CCP_T}},
+        {5, {umat_plasticity_kin_iso_CCP, umat_plasticity_kin_iso_CCP_T}},
+        {6, {umat_sma_unified_T, umat_sma_unified_T_T}},
+        {7, {umat_damage_LLD_0, NULL}}
+    };
+    return list_functions;
+}
+
+int find_umat(const string &umat_name)
+{
+    auto it = umat_names().find(umat_name);
+    if (it == umat_names().end())
+        return umat_unknown;
+    return it->second;
+}
+
+int register_umat(const string &umat_name, umat_M_function umat_M, umat_T_function umat_T)
+{
+    int id = find_umat(umat_name);
+    if (id == umat_unknown) {
+        id = umat_user + int(umat_names().size());
+        umat_names()[umat_name] = id;
+    }
+    else if (id < umat_user) {
+        cout << "Warning: the built-in constitutive law " << umat_name << " is replaced by a user-defined one\n";
+    }
+    umat_functions()[id] = {umat_M, umat_T};
+    return id;
+}
+
+umat_M_function find_umat_M(const int &id)
+{
+    auto it = umat_functions().find(id);
+    if (it == umat_functions().end())
+        return NULL;
+    return it->second.umat_M;
+}
+
+umat_T_function find_umat_T(const int &id)
+{
+    auto it = umat_functions().find(id);
+    if (it == umat_functions().end())
+        return NULL;
+    return it->second.umat_T;
+}
+
+} //namespace smart
@@ -21,7 +21,6 @@
 ///@version 1.0
 
 #include <iostream>
-#include <map>
 #include <fstream>
 #include <assert.h>
 #include <string.h>
@@ -31,23 +30,14 @@
 #include <smartplus/parameter.hpp>
 #include <smartplus/Umat/umat_smart.hpp>
 
-#include <smartplus/Umat/Mechanical/Elasticity/elastic_isotropic.hpp>
-#include <smartplus/Umat/Mechanical/Elasticity/elastic_transverse_isotropic.hpp>
-#include <smartplus/Umat/Mechanical/Elasticity/elastic_orthotropic.hpp>
-#include <smartplus/Umat/Mechanical/Plasticity/plastic_isotropic_ccp.hpp>
-#include <smartplus/Umat/Mechanical/Plasticity/plastic_kin_iso_ccp.hpp>
-#include <smartplus/Umat/Mechanical/SMA/unified_T.hpp>
-#include <smartplus/Umat/Mechanical/Damage/damage_LLD_0.hpp>
-
-#include <smartplus/Umat/Thermomechanical/Elasticity/elastic_isotropic.hpp>
-#include <smartplus/Umat/Thermomechanical/Plasticity/plastic_isotropic_ccp.hpp>
-#include <smartplus/Umat/Thermomechanical/Plasticity/plastic_kin_iso_ccp.hpp>
-#include <smartplus/Umat/Thermomechanical/SMA/unified_T.hpp>
+#include <smartplus/Umat/umat_registry.hpp>
 
 #include <smartplus/Libraries/Phase/material_characteristics.hpp>
 #include <smartplus/Libraries/Phase/phase_characteristics.hpp>
 #include <smartplus/Libraries/Phase/state_variables_M.hpp>
 #include <smartplus/Libraries/Phase/state_variables_T.hpp>
+#include <smartplus/Libraries/Maths/rotation.hpp>
+#include <smartplus/Libraries/Maths/rotation_operators.hpp>
 
 #include <smartplus/Micromechanics/multiphase.hpp>
 
@@ -218,89 +208,47 @@ void abaqus2smartT(double *stress, double *ddsdde, double *ddsddt, double *drpld
     
 void select_umat_T(phase_characteristics &rve, const mat &DR,const double &Time,const double &DTime, const int &ndi, const int &nshr, const bool &start, double &tnew_dt)
 {
-    std::map<string, int> list_umat;
-    list_umat = {{"ELISO",1},{"ELIST",2},{"ELORT",3},{"EPICP",4},{"EPKCP",5},{"SMAUT",6}};
-
-    rve.global2local();
-    auto umat_T = std::dynamic_pointer_cast<state_variables_T>(rve.sptr_sv_local);
+    //The id is normally resolved when the material is read or updated, this covers a umat_name set directly
+    if (rve.sptr_matprops->umat_id == umat_unknown)
+        rve.sptr_matprops->umat_id = find_umat(rve.sptr_matprops->umat_name);
     
-    switch (list_umat[rve.sptr_matprops->umat_name]) {
-        case 1: {
-            umat_elasticity_iso_T(umat_T->Etot, umat_T->DEtot, umat_T->sigma, umat_T->r, umat_T->dSdE, umat_T->dSdT, umat_T->drdE, umat_T->drdT, DR, rve.sptr_matprops->nprops, rve.sptr_matprops->props, umat_T->nstatev, umat_T->statev, umat_T->T, umat_T->DT, Time, DTime, umat_T->Wm(0), umat_T->Wm(1), umat_T->Wm(2), umat_T->Wm(3), umat_T->Wt(0), umat_T->Wt(1), umat_T->Wt(2), ndi, nshr, start, tnew_dt);
-            break;
-        }
-        case 4: {
-            umat_plasticity_iso_CCP_T(umat_T->Etot, umat_T->DEtot, umat_T->sigma, umat_T->r, umat_T->dSdE, umat_T->dSdT, umat_T->drdE, umat_T->drdT, DR, rve.sptr_matprops->nprops, rve.sptr_matprops->props, umat_T->nstatev, umat_T->statev, umat_T->T, umat_T->DT, Time, DTime, umat_T->Wm(0), umat_T->Wm(1), umat_T->Wm(2), umat_T->Wm(3), umat_T->Wt(0), umat_T->Wt(1), umat_T->Wt(2), ndi, nshr, start, tnew_dt);
-            break;
-        }
-        case 5: {
-            umat_plasticity_kin_iso_CCP_T(umat_T->Etot, umat_T->DEtot, umat_T->sigma, umat_T->r, umat_T->dSdE, umat_T->dSdT, umat_T->drdE, umat_T->drdT, DR, rve.sptr_matprops->nprops, rve.sptr_matprops->props, umat_T->nstatev, umat_T->statev, umat_T->T, umat_T->DT, Time, DTime, umat_T->Wm(0), umat_T->Wm(1), umat_T->Wm(2), umat_T->Wm(3), umat_T->Wt(0), umat_T->Wt(1), umat_T->Wt(2), ndi, nshr, start, tnew_dt);
-            break;
-        }
-        case 6: {
-            umat_sma_unified_T_T(umat_T->Etot, umat_T->DEtot, umat_T->sigma, umat_T->r, umat_T->dSdE, umat_T->dSdT, umat_T->drdE, umat_T->drdT, DR, rve.sptr_matprops->nprops, rve.sptr_matprops->props, umat_T->nstatev, umat_T->statev, umat_T->T, umat_T->DT, Time, DTime, umat_T->Wm(0), umat_T->Wm(1), umat_T->Wm(2), umat_T->Wm(3), umat_T->Wt(0), umat_T->Wt(1), umat_T->Wt(2), ndi, nshr, start, tnew_dt);
-            break;
-        }
-            
-            
-        default: {
-            cout << "Error: The choice of Thermomechanical Umat could not be found in the umat library :" << rve.sptr_matprops->umat_name << "\n";
-                exit(0);
-        }
+    umat_T_function umat_function = find_umat_T(rve.sptr_matprops->umat_id);
+    if (umat_function == NULL) {
+        cout << "Error: The choice of Thermomechanical Umat could not be found in the umat library :" << rve.sptr_matprops->umat_name << "\n";
+        exit(0);
     }
+    
+    rve.global2local();
+    auto umat_T = rve.sv_local_as<state_variables_T>();
+    
+    umat_function(umat_T->Etot, umat_T->DEtot, umat_T->sigma, umat_T->r, umat_T->dSdE, umat_T->dSdT, umat_T->drdE, umat_T->drdT, DR, rve.sptr_matprops->nprops, rve.sptr_matprops->props, umat_T->nstatev, umat_T->statev, umat_T->T, umat_T->DT, Time, DTime, umat_T->Wm(0), umat_T->Wm(1), umat_T->Wm(2), umat_T->Wm(3), umat_T->Wt(0), umat_T->Wt(1), umat_T->Wt(2), ndi, nshr, start, tnew_dt);
+    
     rve.local2global();
     
 }
     
 void select_umat_M(phase_characteristics &rve, const mat &DR,const double &Time,const double &DTime, const int &ndi, const int &nshr, const bool &start, double &tnew_dt)
 {
-	
-    std::map<string, int> list_umat;
-    list_umat = {{"ELISO",1},{"ELIST",2},{"ELORT",3},{"EPICP",4},{"EPKCP",5},{"SMAUT",6},{"LLDM0",7},{"MIHEN",100},{"MIMTN",101},{"MISCN",102},{"MIPCW",103},{"MIPLN",104}};
-    
-        rve.global2local();
-        auto umat_M = std::dynamic_pointer_cast<state_variables_M>(rve.sptr_sv_local);
-    
-        switch (list_umat[rve.sptr_matprops->umat_name]) {
-                
-            case 1: {
-                umat_elasticity_iso(umat_M->Etot, umat_M->DEtot, umat_M->sigma, umat_M->Lt, DR, rve.sptr_matprops->nprops, rve.sptr_matprops->props, umat_M->nstatev, umat_M->statev, umat_M->T, umat_M->DT, Time, DTime, umat_M->Wm(0), umat_M->Wm(1), umat_M->Wm(2), umat_M->Wm(3), ndi, nshr, start, tnew_dt);
-                break;
-            }
-            case 2: {
-                umat_elasticity_trans_iso(umat_M->Etot, umat_M->DEtot, umat_M->sigma, umat_M->Lt, DR, rve.sptr_matprops->nprops, rve.sptr_matprops->props, umat_M->nstatev, umat_M->statev, umat_M->T, umat_M->DT, Time, DTime, umat_M->Wm(0), umat_M->Wm(1), umat_M->Wm(2), umat_M->Wm(3), ndi, nshr, start, tnew_dt);
-                break;
-            }
-            case 3: {
-                umat_elasticity_ortho(umat_M->Etot, umat_M->DEtot, umat_M->sigma, umat_M->Lt, DR, rve.sptr_matprops->nprops, rve.sptr_matprops->props, umat_M->nstatev, umat_M->statev, umat_M->T, umat_M->DT, Time, DTime, umat_M->Wm(0), umat_M->Wm(1), umat_M->Wm(2), umat_M->Wm(3), ndi, nshr, start, tnew_dt);
-                break;
-            }
-            case 4: {
-                umat_plasticity_iso_CCP(umat_M->Etot, umat_M->DEtot, umat_M->sigma, umat_M->Lt, DR, rve.sptr_matprops->nprops, rve.sptr_matprops->props, umat_M->nstatev, umat_M->statev, umat_M->T, umat_M->DT, Time, DTime, umat_M->Wm(0), umat_M->Wm(1), umat_M->Wm(2), umat_M->Wm(3), ndi, nshr, start, tnew_dt);
-                break;
-            }
-            case 5: {
-                umat_plasticity_kin_iso_CCP(umat_M->Etot, umat_M->DEtot, umat_M->sigma, umat_M->Lt, DR, rve.sptr_matprops->nprops, rve.sptr_matprops->props, umat_M->nstatev, umat_M->statev, umat_M->T, umat_M->DT, Time, DTime, umat_M->Wm(0), umat_M->Wm(1), umat_M->Wm(2), umat_M->Wm(3), ndi, nshr, start, tnew_dt);
-                break;
-            }
-            case 6: {
-                umat_sma_unified_T(umat_M->Etot, umat_M->DEtot, umat_M->sigma, umat_M->Lt, DR, rve.sptr_matprops->nprops, rve.sptr_matprops->props, umat_M->nstatev, umat_M->statev, umat_M->T, umat_M->DT, Time, DTime, umat_M->Wm(0), umat_M->Wm(1), umat_M->Wm(2), umat_M->Wm(3), ndi, nshr, start, tnew_dt);
-                break;
-            }
-            case 7: {
-                umat_damage_LLD_0(umat_M->Etot, umat_M->DEtot, umat_M->sigma, umat_M->Lt, DR, rve.sptr_matprops->nprops, rve.sptr_matprops->props, umat_M->nstatev, umat_M->statev, umat_M->T, umat_M->DT, Time, DTime, umat_M->Wm(0), umat_M->Wm(1), umat_M->Wm(2), umat_M->Wm(3), ndi, nshr, start, tnew_dt);
-                break;
-            }
-            case 100: case 101: case 102: case 103: case 104: {
-                umat_multi(rve, DR, Time, DTime, ndi, nshr, start, tnew_dt, list_umat[rve.sptr_matprops->umat_name]);
-                break;
-            }
-            default: {
-                cout << "Error: The choice of Umat could not be found in the umat library :" << rve.sptr_matprops->umat_name << "\n";
-                exit(0);
-            }
-        }
-        rve.local2global();
+    if (rve.sptr_matprops->umat_id == umat_unknown)
+        rve.sptr_matprops->umat_id = find_umat(rve.sptr_matprops->umat_name);
+    
+    int umat_id = rve.sptr_matprops->umat_id;
+    umat_M_function umat_function = find_umat_M(umat_id);
+    
+    rve.global2local();
+    auto umat_M = rve.sv_local_as<state_variables_M>();
+    
+    if (umat_function != NULL) {
+        umat_function(umat_M->Etot, umat_M->DEtot, umat_M->sigma, umat_M->Lt, DR, rve.sptr_matprops->nprops, rve.sptr_matprops->props, umat_M->nstatev, umat_M->statev, umat_M->T, umat_M->DT, Time, DTime, umat_M->Wm(0), umat_M->Wm(1), umat_M->Wm(2), umat_M->Wm(3), ndi, nshr, start, tnew_dt);
+    }
+    else if (find_scheme(umat_id) != NULL) {
+        umat_multi(rve, DR, Time, DTime, ndi, nshr, start, tnew_dt, umat_id);
+    }
+    else {
+        cout << "Error: The choice of Umat could not be found in the umat library :" << rve.sptr_matprops->umat_name << "\n";
+        exit(0);
+    }
+    rve.local2global();
 
 }
 
@@ -328,6 +276,66 @@ void run_umat_M(phase_characteristics &rve, const mat &DR,const double &Time,con
     }
 }	
 
+void run_umat_M_batch(const string &umat_name, const vec &props, const int &nstatev, const double &psi_mat, const double &theta_mat, const double &phi_mat, const mat &Etot, const mat &DEtot, mat &sigma, cube &Lt, mat &statev, mat &Wm, const vec &T, const vec &DT, const cube &DR, const double &Time, const double &DTime, const int &ndi, const int &nshr, bool &start, double &tnew_dt, const int &nthreads)
+{
+    int npoints = Etot.n_cols;
+    int nprops = props.n_elem;
+    
+    assert(DEtot.n_cols == Etot.n_cols);
+    assert(sigma.n_cols == Etot.n_cols);
+    assert(Lt.n_slices == Etot.n_cols);
+    assert(statev.n_rows == (unsigned int)nstatev);
+    assert(statev.n_cols == Etot.n_cols);
+    assert(Wm.n_rows == 4);
+    assert(Wm.n_cols == Etot.n_cols);
+    assert(T.n_elem == Etot.n_cols);
+    assert(DT.n_elem == Etot.n_cols);
+    assert(DR.n_slices == Etot.n_cols);
+    
+    //The law is resolved once for the whole batch. Multiphase laws need a microstructure per point and are not batched
+    umat_M_function umat_function = find_umat_M(find_umat(umat_name));
+    if (umat_function == NULL) {
+        cout << "Error: The choice of Umat could not be found in the single-phase umat library :" << umat_name << "\n";
+        exit(0);
+    }
+    
+    //The rotation operators of the material orientation are the same for all the points
+    rotation_operators rot(psi_mat, theta_mat, phi_mat);
+    vec tnew_dt_points = ones(npoints);
+    
+    #pragma omp parallel for num_threads(nthreads) schedule(static)
+    for (int i=0; i<npoints; i++) {
+        
+        //The outputs are views on the columns of the batch buffers, so that the law writes in place
+        vec sigma_i(sigma.colptr(i), 6, false, true);
+        mat Lt_i(Lt.slice_memptr(i), 6, 6, false, true);
+        vec statev_i(statev.colptr(i), nstatev, false, true);
+        
+        if (!rot.identity) {
+            vec Etot_loc = rot.QE_g2l*Etot.col(i);
+            vec DEtot_loc = rot.QE_g2l*DEtot.col(i);
+            vec sigma_loc = rot.QS_g2l*sigma_i;
+            mat Lt_loc = rot.g2l_L(Lt_i);
+            
+            umat_function(Etot_loc, DEtot_loc, sigma_loc, Lt_loc, DR.slice(i), nprops, props, nstatev, statev_i, T(i), DT(i), Time, DTime, Wm(0,i), Wm(1,i), Wm(2,i), Wm(3,i), ndi, nshr, start, tnew_dt_points(i));
+            
+            sigma_i = rot.QS_l2g*sigma_loc;
+            Lt_i = rot.l2g_L(Lt_loc);
+        }
+        else {
+            vec Etot_i = Etot.col(i);
+            vec DEtot_i = DEtot.col(i);
+            umat_function(Etot_i, DEtot_i, sigma_i, Lt_i, DR.slice(i), nprops, props, nstatev, statev_i, T(i), DT(i), Time, DTime, Wm(0,i), Wm(1,i), Wm(2,i), Wm(3,i), ndi, nshr, start, tnew_dt_points(i));
+        }
+    }
+    
+    tnew_dt = tnew_dt_points.min();
+    
+    if (Time + DTime > limit) {
+        start = false;
+    }
+}
+
 void smart2abaqus(double *stress, double *ddsdde, double *statev, const int &ndi, const int &nshr, const vec &sigma, const mat &Lt, const vec &statev_smart, double &pnewdt, const double &tnew_dt)
 {
  
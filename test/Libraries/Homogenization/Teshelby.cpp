@@ -26,6 +26,7 @@
 #include <armadillo>
 #include <smartplus/parameter.hpp>
 #include <smartplus/Libraries/Homogenization/eshelby.hpp>
+#include <smartplus/Libraries/Continuum_Mechanics/constitutive.hpp>
 
 using namespace std;
 using namespace arma;
@@ -90,3 +91,164 @@ BOOST_AUTO_TEST_CASE( S_TII )
     BOOST_CHECK( norm(T_II_num*Lt-S_anal,2) < 1.E-4 );
     
 }
+
+BOOST_AUTO_TEST_CASE( Gauss_calG )
+{
+    
+    double a1 = 3.;
+    double a2 = 1.5;
+    double a3 = 1.;
+    int mp = 20;
+    int np = 20;
+    
+    mat Lt = zeros(6,6);
+    Lt(0,0) = 150000.;
+    Lt(0,1) = 40000.;
+    Lt(0,2) = 35000.;
+    Lt(1,0) = 40000.;
+    Lt(1,1) = 90000.;
+    Lt(1,2) = 30000.;
+    Lt(2,0) = 35000.;
+    Lt(2,1) = 30000.;
+    Lt(2,2) = 80000.;
+    Lt(3,3) = 25000.;
+    Lt(4,4) = 22000.;
+    Lt(5,5) = 18000.;
+    
+    vec x = zeros(mp);
+    vec wx = zeros(mp);
+    vec y = zeros(np);
+    vec wy = zeros(np);
+    points(x, wx, y, wy, mp, np);
+    
+    Mat<int> Id = { {0,3,4}, {3,1,5}, {4,5,2} };
+    
+    //Point by point integration with calG
+    mat G_ref = zeros(6,6);
+    mat H = zeros(6,6);
+    for (int l=0; l<mp; l++) {
+        for (int i=0; i<np; i++) {
+            calG(y(i), a1, a2, a3, x(l), Id, Lt, H);
+            G_ref += wx(l)*wy(i)*H;
+        }
+    }
+    
+    mat G = zeros(6,6);
+    Gauss(Lt, G, a1, a2, a3, x, wx, y, wy, mp, np);
+    
+    BOOST_CHECK( norm(G-G_ref,2) < 1.E-9*norm(G_ref,2) );
+}
+
+BOOST_AUTO_TEST_CASE( Eshelby_memo )
+{
+    BOOST_REQUIRE( eshelby_cache_size > 0 );
+    
+    double a1 = 3.;
+    double a2 = 1.5;
+    double a3 = 1.;
+    auto gp = get_Gauss_points(10, 10);
+    
+    mat Lt = zeros(6,6);
+    Lt(0,0) = 150000.;
+    Lt(0,1) = 40000.;
+    Lt(0,2) = 35000.;
+    Lt(1,0) = 40000.;
+    Lt(1,1) = 90000.;
+    Lt(1,2) = 30000.;
+    Lt(2,0) = 35000.;
+    Lt(2,1) = 30000.;
+    Lt(2,2) = 80000.;
+    Lt(3,3) = 25000.;
+    Lt(4,4) = 22000.;
+    Lt(5,5) = 18000.;
+    
+    //Fill the cache with keys of other aspect ratios, whatever its previous content
+    int nkeys = 0;
+    for (int i=0; i<eshelby_cache_size; i++, nkeys++) {
+        Eshelby_cached(Lt, 10.+nkeys, a2, a3, *gp);
+    }
+    
+    //The first evaluation performs the quadrature, the second one returns the same tensor
+    unsigned long misses = Eshelby_cache_misses();
+    mat S_1 = Eshelby_cached(Lt, a1, a2, a3, *gp);
+    BOOST_CHECK( Eshelby_cache_misses() == misses+1 );
+    BOOST_CHECK( norm(S_1 - Eshelby(Lt, a1, a2, a3, *gp),2) < 1.E-9*norm(S_1,2) );
+    mat S_2 = Eshelby_cached(Lt, a1, a2, a3, *gp);
+    BOOST_CHECK( Eshelby_cache_misses() == misses+1 );
+    BOOST_CHECK( accu(S_2 != S_1) == 0 );
+    
+    //First in, first out: S_1 survives eshelby_cache_size-1 new keys, and is evicted by the next one
+    for (int i=0; i<eshelby_cache_size-1; i++, nkeys++) {
+        Eshelby_cached(Lt, 10.+nkeys, a2, a3, *gp);
+    }
+    misses = Eshelby_cache_misses();
+    S_2 = Eshelby_cached(Lt, a1, a2, a3, *gp);
+    BOOST_CHECK( Eshelby_cache_misses() == misses );
+    BOOST_CHECK( accu(S_2 != S_1) == 0 );
+    
+    Eshelby_cached(Lt, 10.+nkeys, a2, a3, *gp);
+    misses = Eshelby_cache_misses();
+    S_2 = Eshelby_cached(Lt, a1, a2, a3, *gp);
+    BOOST_CHECK( Eshelby_cache_misses() == misses+1 );
+    
+    //With a tolerance, a nearly identical tangent reuses the cached tensor, a different one does not
+    mat Lt_near = Lt*(1.+1.E-10);
+    mat Lt_far = Lt;
+    Lt_far(0,0) *= 1.1;
+    
+    misses = Eshelby_cache_misses();
+    S_2 = Eshelby_cached(Lt_near, a1, a2, a3, *gp, 1.E-8);
+    BOOST_CHECK( Eshelby_cache_misses() == misses );
+    BOOST_CHECK( accu(S_2 != S_1) == 0 );
+    
+    S_2 = Eshelby_cached(Lt_far, a1, a2, a3, *gp, 1.E-8);
+    BOOST_CHECK( Eshelby_cache_misses() == misses+1 );
+    BOOST_CHECK( norm(S_2 - S_1,2) > 1.E-6*norm(S_1,2) );
+    
+    S_2 = Eshelby_cached(Lt_near, a1, a2, a3, *gp, 0.);
+    BOOST_CHECK( Eshelby_cache_misses() == misses+2 );
+}
+
+BOOST_AUTO_TEST_CASE( Eshelby_spheroids )
+{
+    
+    int mp = 100;
+    int np = 100;
+    double E = 70000.;
+    double nu = 0.3;
+    mat Lt = L_iso(E, nu, "Enu");
+    
+    mat S_num = zeros(6,6);
+    mat S_closed = zeros(6,6);
+    
+    //prolate
+    S_num = Eshelby(Lt, 3., 1., 1., mp, np);
+    BOOST_CHECK( Eshelby_closed_form(Lt, 3., 1., 1., S_closed) );
+    BOOST_CHECK( norm(S_num-S_closed,2) < 1.E-4 );
+    
+    //oblate
+    S_num = Eshelby(Lt, 0.3, 1., 1., mp, np);
+    BOOST_CHECK( Eshelby_closed_form(Lt, 0.3, 1., 1., S_closed) );
+    BOOST_CHECK( norm(S_num-S_closed,2) < 1.E-4 );
+    
+    //not a spheroid of axis 1: the quadrature is used
+    BOOST_CHECK( !Eshelby_closed_form(Lt, 1., 3., 1., S_closed) );
+    
+    //The isotropy check is relative: moduli in Pa use the closed form, a transversely isotropic matrix does not
+    BOOST_CHECK( Eshelby_closed_form(L_iso(70.E9, nu, "Enu"), 3., 1., 1., S_closed) );
+    BOOST_CHECK( norm(S_closed-Eshelby_prolate(nu, 3.),2) < 1.E-9 );
+    BOOST_CHECK( !Eshelby_closed_form(L_isotrans(70000., 30000., 0.3, 0.3, 20000., 1), 3., 1., 1., S_closed) );
+    
+    //The Hill tensor of the fast path
+    mat T_II_closed = T_II_cached(Lt, 3., 1., 1., *get_Gauss_points(mp, np));
+    BOOST_CHECK( norm(T_II_closed*Lt-Eshelby_prolate(nu, 3.),2) < 1.E-9 );
+}
+
+BOOST_AUTO_TEST_CASE( Eshelby_cylinders )
+{
+    
+    double nu = 0.3;
+    
+    //The infinite cylinder is the limit of the prolate spheroid of axis 1
+    BOOST_CHECK( norm(Eshelby_prolate(nu, 1.E3)-Eshelby_cylinder(nu),2) < 1.E-4 );
+}
@@ -0,0 +1,118 @@
+/* This file is part of SMART+.
+ 
+ SMART+ is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ SMART+ is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with SMART+.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+
+///@file Tkey_bindings.cpp
+///@brief Test for the binding of the keys of an identification
+///@version 1.0
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "key_bindings"
+#include <boost/test/unit_test.hpp>
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+#include <string>
+#include <vector>
+#include <armadillo>
+#include <smartplus/Libraries/Identification/parameters.hpp>
+#include <smartplus/Libraries/Identification/constants.hpp>
+#include <smartplus/Libraries/Identification/key_bindings.hpp>
+
+using namespace std;
+using namespace arma;
+using namespace smart;
+
+//Material file of an isotropic elastic law, with the properties E and nu given as tokens
+static void write_material(const string &path, const string &E, const string &nu)
+{
+    ofstream mat(path);
+    mat << "Material\nName ELISO\nNumber_of_material_parameters 3\nNumber_of_internal_variables 1\n\n";
+    mat << "#Orientation\npsi 0\ntheta 0\nphi 0\n\n";
+    mat << "#Mechanical\nE " << E << "\nnu " << nu << "\nalpha 1.E-5\n";
+}
+
+//Loading path of a tension test, with the initial temperature keyed by @T
+static void write_path(const string &path)
+{
+    ofstream pa(path);
+    pa << "#Initial_temperature\n@T\n#Number_of_blocks\n1\n\n";
+    pa << "#Block\n1\n#Loading_type\n1\n#Repeat\n1\n#Steps\n1\n\n";
+    pa << "#Mode\n1\n#Dn_init 1.\n#Dn_mini 0.1\n#Dn_inc 0.1\n#time\n1\n";
+    pa << "#Consigne\nE 0.01\nS 0 S 0\nS 0 S 0 S 0\n#Consigne_T\nT @T\n";
+}
+
+static void write_output(const string &path)
+{
+    ofstream ou(path);
+    ou << "#Outpout_values\nMeca   6\n0   1   2   3   4   5\nT   1\n\n";
+    ou << "Number_of_wanted_internal_variables\t0\n\n";
+    ou << "#Block #type_1_N_2_T    #every\n1      1                1\n";
+}
+
+BOOST_AUTO_TEST_CASE( bind_keys )
+{
+    string path_data = "data_kb";
+    string path_keys = "keys_kb";
+    boost::filesystem::create_directories(path_data);
+    boost::filesystem::create_directories(path_keys);
+    
+    write_material(path_keys + "/material.dat", "@E", "@nu");
+    write_material(path_keys + "/material_product.dat", "2*@E", "0.3");
+    write_path(path_keys + "/path_id_1.txt");
+    write_output(path_data + "/output.dat");
+    
+    int nfiles = 1;
+    vector<parameters> params = {parameters(0, 1000., 100000., "@E", 1, {"material.dat"})};
+    vec nu_values = {0.3};
+    vec T_values = {290.};
+    vector<constants> consts = {constants(0, 0.3, nu_values, "@nu", 1, {"material.dat"}), constants(1, 290., T_values, "@T", 1, {"path_id_1.txt"})};
+    
+    //Keyed material file, and constant keyed in the loading path
+    key_bindings kb;
+    kb.bind(params, consts, nfiles, path_data, path_keys, "material.dat");
+    BOOST_CHECK( kb.in_memory );
+    BOOST_CHECK( kb.umat_name == "ELISO" );
+    BOOST_CHECK( kb.nstatev == 1 );
+    BOOST_CHECK( kb.props_params.size() == 1 );
+    BOOST_CHECK( kb.props_consts.size() == 1 );
+    BOOST_CHECK( kb.blocks.size() == 1 );
+    BOOST_CHECK( kb.so.size() == 1 );
+    BOOST_CHECK( kb.contexts.size() == 1 );
+    BOOST_CHECK_SMALL( kb.T_init(0) - 290., 1.E-9 );
+    
+    vec p = {70000.};
+    vec props = kb.material_props(p, consts, 0);
+    BOOST_CHECK_SMALL( props(0) - 70000., 1.E-9 );
+    BOOST_CHECK_SMALL( props(1) - 0.3, 1.E-9 );
+    BOOST_CHECK_SMALL( props(2) - 1.E-5, 1.E-12 );
+    
+    //Key within a longer token: the keys have to be substituted in the files
+    vector<parameters> params_product = {parameters(0, 1000., 100000., "@E", 1, {"material_product.dat"})};
+    vector<constants> consts_path = {consts[1]};
+    key_bindings kb_product;
+    kb_product.bind(params_product, consts_path, nfiles, path_data, path_keys, "material_product.dat");
+    BOOST_CHECK( !kb_product.in_memory );
+    
+    //Key in another file than the material file and the loading paths
+    vector<parameters> params_other = {parameters(0, 1000., 100000., "@E", 2, {"material.dat", "Nellipsoids0.dat"})};
+    key_bindings kb_other;
+    kb_other.bind(params_other, consts, nfiles, path_data, path_keys, "material.dat");
+    BOOST_CHECK( !kb_other.in_memory );
+    
+    boost::filesystem::remove_all(path_data);
+    boost::filesystem::remove_all(path_keys);
+}
@@ -0,0 +1,59 @@
+/* This file is part of SMART+.
+ 
+ SMART+ is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ SMART+ is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with SMART+.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+///@file Tanderson.cpp
+///@brief Test for the Anderson acceleration of fixed-point iterations
+///@version 1.0
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "anderson"
+#include <boost/test/unit_test.hpp>
+
+#include <armadillo>
+#include <smartplus/parameter.hpp>
+#include <smartplus/Libraries/Maths/anderson.hpp>
+
+using namespace std;
+using namespace arma;
+using namespace smart;
+
+BOOST_AUTO_TEST_CASE( Anderson_linear )
+{
+    //Linear contraction x = Mx + b, slow for the plain iteration (spectral radius 0.95)
+    vec eigen = {0.2, 0.5, 0.8, 0.95, 0.2, 0.5, 0.8, 0.95, 0.2, 0.5, 0.8, 0.95};
+    mat M = diagmat(eigen);
+    vec b = ones(12);
+    vec x_ref = solve(eye(12,12) - M, b);
+    
+    Anderson_mixing accelerator(5);
+    vec x = zeros(12);
+    int nbiter = 0;
+    double error = 1.;
+    while ((error > 1.E-10)&&(nbiter < 100)) {
+        vec g = M*x + b;
+        error = norm(g - x,2);
+        x = accelerator.update(x, g);
+        nbiter++;
+    }
+    
+    BOOST_CHECK( nbiter < 20 );
+    BOOST_CHECK( norm(x - x_ref,2) < 1.E-8 );
+    
+    //Without history the plain iterate is returned
+    Anderson_mixing plain(0);
+    vec x0 = ones(12);
+    BOOST_CHECK( norm(plain.update(x0, M*x0 + b) - (M*x0 + b),2) < iota );
+}
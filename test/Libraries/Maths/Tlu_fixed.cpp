@@ -0,0 +1,68 @@
+/* This file is part of SMART+.
+ 
+ SMART+ is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ SMART+ is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with SMART+.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+
+///@file Tlu_fixed.cpp
+///@brief Test for the LU decomposition of small systems on stack storage
+///@version 1.0
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "lu_fixed"
+#include <boost/test/unit_test.hpp>
+
+#include <armadillo>
+#include <smartplus/parameter.hpp>
+#include <smartplus/Libraries/Maths/lu_fixed.hpp>
+#include <smartplus/Libraries/Solver/read.hpp>
+
+using namespace std;
+using namespace arma;
+using namespace smart;
+
+BOOST_AUTO_TEST_CASE( LU_fixed_mixed )
+{
+    //Mixed system of the solver: stress controlled in 1 and 4, strain controlled elsewhere
+    mat Lt = {{70000., 30000., 30000., 0., 0., 0.}, {30000., 70000., 30000., 0., 0., 0.}, {30000., 30000., 70000., 0., 0., 0.}, {0., 0., 0., 20000., 0., 0.}, {0., 0., 0., 0., 20000., 0.}, {0., 0., 0., 0., 0., 20000.}};
+    Col<int> cBC_meca = {1, 0, 0, 1, 0, 0};
+    vec residual = {10., 1.E-3, -2.E-3, 5., 0., 1.E-3};
+    
+    mat K;
+    Lt_2_K(Lt, K, cBC_meca, lambda_solver);
+    vec Delta_ref = -solve(K, residual);
+    
+    LU_fixed<6> K_fixed;
+    Lt_2_K(Lt, K_fixed, cBC_meca, lambda_solver);
+    BOOST_CHECK( K_fixed.factorize() );
+    vec Delta = zeros(6);
+    K_fixed.solve(residual, Delta);
+    Delta *= -1.;
+    BOOST_CHECK( norm(Delta - Delta_ref,2) < 1.E-9*norm(Delta_ref,2) );
+    
+    //Pivoting is needed for this one, and a singular matrix is detected
+    LU_fixed<7> P;
+    for (int i=0; i<7; i++)
+        P(i, 6-i) = double(i+1);
+    BOOST_CHECK( P.factorize() );
+    vec b = linspace(1., 7., 7);
+    vec x = zeros(7);
+    P.solve(b, x);
+    BOOST_CHECK( fabs(x(6) - 1.) < iota );
+    BOOST_CHECK( fabs(x(0) - 1.) < iota );
+    
+    LU_fixed<7> S;
+    S(0,0) = 1.;
+    BOOST_CHECK( !S.factorize() );
+}
@@ -26,6 +26,8 @@
 #include <armadillo>
 #include <smartplus/parameter.hpp>
 #include <smartplus/Libraries/Maths/rotation.hpp>
+#include <smartplus/Libraries/Maths/rotation_operators.hpp>
+#include <smartplus/Libraries/Continuum_Mechanics/constitutive.hpp>
 #include <smartplus/Libraries/Homogenization/eshelby.hpp>
 
 using namespace std;
@@ -69,3 +71,34 @@ BOOST_AUTO_TEST_CASE( rotation )
     BOOST_CHECK( norm(S_c3-S_c2,2) < 1.E-9 );
     
 }
+
+BOOST_AUTO_TEST_CASE( rotation_operators_composed )
+{
+    
+    vec test = zeros(6);
+    test(0) = 4.;
+    test(1) = 2.;
+    test(2) = 6.;
+    test(3) = 8.;
+    test(4) = 3.;
+    test(5) = 7.;
+    
+    double psi = 12.5*(pi/180.);
+    double theta = 32.*(pi/180.);
+    double phi = -4.5*(pi/180.);
+    
+    mat L = L_ortho(120.,90.,50.,0.25,0.32,0.3,30.,40.,25., "EnuG");
+    mat A = Eshelby_cylinder(0.12);
+    
+    rotation_operators rot(psi, theta, phi);
+    
+    //The composed operators must match the successive rotations
+    BOOST_CHECK( norm(rot.QS_g2l*test - rotate_g2l_stress(test, psi, theta, phi),2) < 1.E-9 );
+    BOOST_CHECK( norm(rot.QE_l2g*test - rotate_l2g_strain(test, psi, theta, phi),2) < 1.E-9 );
+    BOOST_CHECK( norm(rot.g2l_L(L) - rotate_g2l_L(L, psi, theta, phi),2) < 1.E-9 );
+    BOOST_CHECK( norm(rot.l2g_M(L) - rotate_l2g_M(L, psi, theta, phi),2) < 1.E-9 );
+    BOOST_CHECK( norm(rot.l2g_A(A) - rotate_l2g_A(A, psi, theta, phi),2) < 1.E-9 );
+    
+    //l2g is the inverse of g2l
+    BOOST_CHECK( norm(rot.l2g_L(rot.g2l_L(L)) - L,2) < 1.E-9 );
+}
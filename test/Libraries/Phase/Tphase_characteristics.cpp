@@ -138,3 +138,27 @@ BOOST_AUTO_TEST_CASE( read_write )
     BOOST_CHECK_EQUAL_COLLECTIONS(b1_cylinder, e1_cylinder, b2_cylinder, e2_cylinder);
     
 }
+
+BOOST_AUTO_TEST_CASE( visit )
+{
+    string umat_name = "MIMTN";
+    string path_data = "data";
+    vec props = {2,0};
+    
+    phase_characteristics rve;
+    rve.sptr_matprops->update(0, umat_name, 1, 0., 0., 0., props.n_elem, props);
+    rve.construct(2,1);
+    read_ellipsoid(rve, path_data, "Nellipsoids0.dat");
+    
+    //The views point on the objects shared by the phases, and the traversal goes through every sub-phase
+    int nvisited = 0;
+    int maxlevel = 0;
+    visit_phases(rve, [&](const phase_view &v) {
+        BOOST_CHECK(v.matprops == v.phase->sptr_matprops.get());
+        BOOST_CHECK(v.sv_global == v.phase->sptr_sv_global.get());
+        nvisited++;
+        maxlevel = std::max(maxlevel, v.level);
+    });
+    BOOST_CHECK_EQUAL(nvisited, int(rve.sub_phases.size()) + 1);
+    BOOST_CHECK_EQUAL(maxlevel, 1);
+}
@@ -0,0 +1,115 @@
+/* This file is part of SMART+.
+ 
+ SMART+ is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ SMART+ is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with SMART+.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+///@file Toutput.cpp
+///@brief Test for the binary result files of the solver
+///@version 1.0
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "output"
+#include <boost/test/unit_test.hpp>
+
+#include <fstream>
+#include <sstream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <armadillo>
+#include <smartplus/parameter.hpp>
+#include <smartplus/Libraries/Solver/output.hpp>
+#include <smartplus/Libraries/Solver/output_writer.hpp>
+
+using namespace std;
+using namespace arma;
+using namespace smart;
+
+BOOST_AUTO_TEST_CASE( binary_records )
+{
+    std::vector<string> names = {"Time", "Etot_0", "sigma_0"};
+    vec r1 = {0.1, 1.E-3, 70.};
+    vec r2 = {0.2, 2.E-3, 140.};
+    
+    ofstream binfile("Toutput.bin", ios::out | ios::trunc | ios::binary);
+    write_binary_header(binfile, names);
+    write_binary_record(binfile, 1, 1, 1, 1, r1);
+    write_binary_record(binfile, 1, 1, 1, 2, r2);
+    binfile.close();
+    
+    std::vector<string> names_read;
+    Mat<int> ids;
+    mat values;
+    read_binary_output("Toutput.bin", names_read, ids, values);
+    
+    BOOST_CHECK( names_read == names );
+    BOOST_CHECK( ids.n_rows == 2 );
+    BOOST_CHECK( ids(1,3) == 2 );
+    //The values are stored without formatting
+    BOOST_CHECK( norm(values.row(0) - trans(r1),2) < iota );
+    BOOST_CHECK( norm(values.row(1) - trans(r2),2) < iota );
+    
+    //The ASCII conversion has the block, cycle, step, inc and the columns
+    binary2ascii("Toutput.bin", "Toutput.txt");
+    mat ascii;
+    ascii.load("Toutput.txt", raw_ascii);
+    BOOST_CHECK( ascii.n_rows == 2 );
+    BOOST_CHECK( ascii.n_cols == 7 );
+    BOOST_CHECK( fabs(ascii(1,6) - 140.) < iota );
+}
+
+BOOST_AUTO_TEST_CASE( writer_thread )
+{
+    //Layout of the ASCII result files: empty column after the time and before the internal variables
+    ostringstream line;
+    vec r = {0.5, 1., 2.};
+    write_ascii_record(line, 1, 1, 1, 1, r, 3);
+    BOOST_CHECK( line.str() == "1\t1\t1\t1\t0.5\t\t1\t2\t\t\n" );
+    
+    //A queue smaller than the number of records: the producer waits for the writer thread
+    auto sptr_out = make_shared<ofstream>("Toutput_async.txt");
+    {
+        output_writer writer(4);
+        for (int i=0; i<100; i++) {
+            r(0) = double(i);
+            writer.push(sptr_out, 0, 1, 1, 1, i+1, r, 3);
+        }
+    }
+    sptr_out->close();
+    
+    mat ascii;
+    ascii.load("Toutput_async.txt", raw_ascii);
+    BOOST_CHECK( ascii.n_rows == 100 );
+    BOOST_CHECK( fabs(ascii(99,3) - 100.) < iota );
+    BOOST_CHECK( fabs(ascii(99,4) - 99.) < iota );
+}
+
+BOOST_AUTO_TEST_CASE( results_in_memory )
+{
+    //The records kept in memory have the columns of the result files
+    solver_results results;
+    vec values = {0.5, 1., 2.};
+    results.push(1, 1, 1, 1, values);
+    results.push(1, 1, 2, 3, 2.*values);
+    
+    mat records = results.records();
+    BOOST_CHECK( results.size() == 2 );
+    BOOST_CHECK( records.n_rows == 2 );
+    BOOST_CHECK( records.n_cols == 7 );
+    BOOST_CHECK( fabs(records(1,3) - 3.) < iota );
+    BOOST_CHECK( fabs(records(1,6) - 4.) < iota );
+    
+    results.clear();
+    BOOST_CHECK( results.size() == 0 );
+}
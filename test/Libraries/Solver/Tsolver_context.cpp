@@ -0,0 +1,68 @@
+/* This file is part of SMART+.
+ 
+ SMART+ is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ SMART+ is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with SMART+.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+///@file Tsolver_context.cpp
+///@brief Test for the runs of the solver with the results kept in memory
+///@version 1.0
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "solver_context"
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+#include <armadillo>
+#include <smartplus/parameter.hpp>
+#include <smartplus/Libraries/Solver/solver.hpp>
+#include <smartplus/Libraries/Solver/solver_context.hpp>
+#include <smartplus/Libraries/Solver/output.hpp>
+
+using namespace std;
+using namespace arma;
+using namespace smart;
+
+BOOST_AUTO_TEST_CASE( MIMTN_runs )
+{
+    //Mori-Tanaka composite with an elastic-plastic matrix (data/Nellipsoids2.dat), loading path data/path.txt, binary results (data/output.dat)
+    string umat_name = "MIMTN";
+    vec props = {2, 2, 30, 30, 0};
+    int nstatev = 1;
+    
+    solver_context context(umat_name, nstatev, 0., 0., 0., "data", "path.txt", "output.dat");
+    
+    //Two runs give the same records
+    mat records_1 = context.run(props);
+    mat records_2 = context.run(props);
+    BOOST_REQUIRE( records_1.n_rows > 0 );
+    BOOST_CHECK( records_1.n_rows == records_2.n_rows );
+    BOOST_CHECK( norm(records_1 - records_2,"inf") < iota );
+    
+    //They are the records of the result file of the file-based solver
+    solver(umat_name, props, nstatev, 0., 0., 0., "data", "results", "path.txt", "Tsolver_context.txt");
+    std::vector<string> names;
+    Mat<int> ids;
+    mat values;
+    read_binary_output("results/Tsolver_context_global-0.txt", names, ids, values);
+    BOOST_REQUIRE( ids.n_rows == records_1.n_rows );
+    BOOST_CHECK( norm(records_1.cols(0,3) - conv_to<mat>::from(ids),"inf") < iota );
+    BOOST_CHECK( norm(records_1.cols(4,records_1.n_cols-1) - values,"inf") < iota );
+    
+    //The initial state is restored by reset
+    context.reset();
+    mat records_3 = context.run(props);
+    BOOST_CHECK( records_3.n_rows == records_1.n_rows );
+    BOOST_CHECK( norm(records_3 - records_1,"inf") < iota );
+}
@@ -0,0 +1,112 @@
+/* This file is part of SMART+.
+ 
+ SMART+ is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ SMART+ is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with SMART+.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+///@file Tmultiphase.cpp
+///@brief Test for the localization loop of the multiphase UMAT
+///@version 1.0
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "multiphase"
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+#include <armadillo>
+#include <smartplus/parameter.hpp>
+#include <smartplus/Libraries/Continuum_Mechanics/constitutive.hpp>
+#include <smartplus/Libraries/Phase/phase_characteristics.hpp>
+#include <smartplus/Libraries/Phase/material_characteristics.hpp>
+#include <smartplus/Libraries/Phase/state_variables_M.hpp>
+#include <smartplus/Micromechanics/schemes.hpp>
+#include <smartplus/Micromechanics/multiphase.hpp>
+
+using namespace std;
+using namespace arma;
+using namespace smart;
+
+//Mori-Tanaka rve of two phases, read from data/Nellipsoids<file>.dat and initialized by a first call of the UMAT
+static void MIMTN_rve(phase_characteristics &rve, const int &file) {
+    
+    vec props = {2, double(file), 30, 30, 0};
+    rve.construct(0,1);
+    rve.sptr_matprops->update(0, "MIMTN", 1, 0., 0., 0., props.n_elem, props);
+    rve.sptr_sv_global->update(zeros(6), zeros(6), zeros(6), zeros(6), 0., 0., 1, zeros(1), zeros(1));
+    rve.sptr_sv_local->update(zeros(6), zeros(6), zeros(6), zeros(6), 0., 0., 1, zeros(1), zeros(1));
+    double tnew_dt = 1.;
+    umat_multi(rve, eye(3,3), 0., 0., 3, 3, true, tnew_dt, 101);
+}
+
+BOOST_AUTO_TEST_CASE( Newton_localization_linear )
+{
+    phase_characteristics rve;
+    MIMTN_rve(rve, 0);
+    int nphases = int(rve.sub_phases.size());
+    BOOST_REQUIRE( nphases == 2 );
+    
+    vec DE_eff = {1.E-3, -3.E-4, -3.E-4, 2.E-4, 0., 1.E-4};
+    rve.sptr_sv_local->DEtot = DE_eff;
+    for(auto &r : rve.sub_phases) {
+        state_variables_M *sv_r = r.sv_global_as<state_variables_M>();
+        sv_r->Lt = L_iso(r.sptr_matprops->props(0), r.sptr_matprops->props(1), "Enu");
+    }
+    
+    //Mori-Tanaka localization A_r = T_r*inv(sumT)
+    DE_Mori_Tanaka(rve, 0);
+    std::vector<vec> DE_MT(nphases);
+    for(int i=0; i<nphases; i++) {
+        DE_MT[i] = rve.sub_phases[i].sptr_sv_global->DEtot;
+    }
+    
+    //For linear elastic phases the residual is linear: a single Newton step from the homogeneous strain gives the same increments
+    std::vector<vec> DEtot_N(nphases, DE_eff);
+    for(auto &r : rve.sub_phases) {
+        state_variables_M *sv_r = r.sv_global_as<state_variables_M>();
+        sv_r->sigma_start = zeros(6);
+        sv_r->sigma = sv_r->Lt*DE_eff;
+    }
+    DE_Newton_localization(rve, 0, DEtot_N, 101);
+    
+    for(int i=0; i<nphases; i++) {
+        BOOST_CHECK( norm(rve.sub_phases[i].sptr_sv_global->DEtot - DE_MT[i],2) < 1.E-9*norm(DE_MT[i],2) );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( Newton_localization_plastic )
+{
+    //Elastic-plastic matrix (EPICP) reinforced by elastic spheres: the increment is well beyond the yield strain of the matrix
+    vec DE_eff = {1.E-2, -5.E-3, -5.E-3, 0., 0., 0.};
+    mat DR = eye(3,3);
+    int nbiter[2];
+    int accelerators[2] = {0, 2};
+    
+    for(int k=0; k<2; k++) {
+        phase_characteristics rve;
+        MIMTN_rve(rve, 2);
+        rve.set_start();
+        
+        double tnew_dt = 1.;
+        rve.sptr_sv_local->DEtot = DE_eff;
+        umat_multi(rve, DR, 0., 1., 3, 3, false, tnew_dt, 101, accelerators[k]);
+        nbiter[k] = rve.sptr_multi->nbiter;
+        
+        //The matrix has yielded
+        BOOST_CHECK( rve.sub_phases[0].sptr_sv_global->statev(1) > 0. );
+    }
+    
+    //Both loops converge, the Newton localization in fewer iterations
+    BOOST_CHECK( nbiter[0] <= maxiter_micro );
+    BOOST_CHECK( nbiter[1] < nbiter[0] );
+}
@@ -0,0 +1,220 @@
+/* This file is part of SMART+.
+ 
+ SMART+ is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ SMART+ is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with SMART+.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+///@file Tschemes.cpp
+///@brief Test for the homogenization schemes of the multiphase UMAT
+///@version 1.0
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "schemes"
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+#include <armadillo>
+#include <smartplus/parameter.hpp>
+#include <smartplus/Libraries/Continuum_Mechanics/constitutive.hpp>
+#include <smartplus/Libraries/Phase/phase_characteristics.hpp>
+#include <smartplus/Libraries/Phase/state_variables_M.hpp>
+#include <smartplus/Libraries/Geometry/layer.hpp>
+#include <smartplus/Libraries/Homogenization/layer_multi.hpp>
+#include <smartplus/Libraries/Maths/rotation.hpp>
+#include <smartplus/Micromechanics/schemes.hpp>
+#include <smartplus/Umat/umat_L_elastic.hpp>
+
+using namespace std;
+using namespace arma;
+using namespace smart;
+
+//Multiphase rve, with the microstructure given by props
+static void multiphase_rve(phase_characteristics &rve, const string &umat_name, const vec &props) {
+    
+    rve.construct(0,1);
+    rve.sptr_matprops->update(0, umat_name, 1, 0., 0., 0., props.n_elem, props);
+    rve.sptr_sv_global->update(zeros(6), zeros(6), zeros(6), zeros(6), 0., 0., 1, zeros(1), zeros(1));
+    rve.sptr_sv_local->update(zeros(6), zeros(6), zeros(6), zeros(6), 0., 0., 1, zeros(1), zeros(1));
+}
+
+BOOST_AUTO_TEST_CASE( Self_Consistent_elastic )
+{
+    //Isotropic matrix (E = 3000, nu = 0.4, c = 0.7) with isotropic spheres (E = 70000, nu = 0.3, c = 0.3), data/Nellipsoids3.dat
+    phase_characteristics rve;
+    vec props = {2, 3, 30, 30, 0};
+    multiphase_rve(rve, "MISCN", props);
+    get_L_elastic(rve);
+    mat L_scheme = rve.sv_global_as<state_variables_M>()->Lt;
+    
+    //Reference: for spheres in an isotropic medium the interaction tensor of the scheme, T = inv(I + S inv(L_eff) (L_r - L_eff)), reduces to two scalars
+    //on the bulk and shear moduli. The matrix has T = I, the fixed point on (k, mu) is then converged far below precision_self_consistent
+    double k0 = 3000./(3.*(1.-2.*0.4));
+    double mu0 = 3000./(2.*(1.+0.4));
+    double k1 = 70000./(3.*(1.-2.*0.3));
+    double mu1 = 70000./(2.*(1.+0.3));
+    double c0 = 0.7;
+    double c1 = 0.3;
+    
+    double k = c0*k0 + c1*k1;
+    double mu = c0*mu0 + c1*mu1;
+    double error = 1.;
+    int nbiter = 0;
+    while ((error > 1.E-14)&&(nbiter < 1000)) {
+        double alpha = 3.*k/(3.*k+4.*mu);
+        double beta = 6.*(k+2.*mu)/(5.*(3.*k+4.*mu));
+        double k_n = c0*k0 + c1*k1/(1.+alpha*(k1-k)/k);
+        double mu_n = c0*mu0 + c1*mu1/(1.+beta*(mu1-mu)/mu);
+        error = fabs(k_n-k)/k + fabs(mu_n-mu)/mu;
+        k = k_n;
+        mu = mu_n;
+        nbiter++;
+    }
+    BOOST_REQUIRE( error < 1.E-14 );
+    
+    mat L_ref = L_iso(k, mu, "Kmu");
+    BOOST_CHECK( norm(L_scheme - L_ref,2) < 1.E-5*norm(L_ref,2) );
+    
+    //From the converged effective tangent, the inner fixed point of a new call stops after one or two passes
+    Lt_Self_Consistent(rve, 0, false, 1);
+    BOOST_CHECK( rve.sptr_multi->nbiter_self_consistent >= 1 );
+    BOOST_CHECK( rve.sptr_multi->nbiter_self_consistent <= 2 );
+}
+
+BOOST_AUTO_TEST_CASE( Mori_Tanaka_cylinder_elastic )
+{
+    //Isotropic matrix (E = 3000, nu = 0.4, c = 0.8) with long isotropic fibres along the direction 1 (E = 70000, nu = 0.3, c = 0.2), data/Ncylinders0.dat
+    phase_characteristics rve;
+    vec props = {2, 0, 30, 30, 0};
+    multiphase_rve(rve, "MIPCW", props);
+    get_L_elastic(rve);
+    mat L = rve.sv_global_as<state_variables_M>()->Lt;
+    
+    //Reference: the Mori-Tanaka estimates of aligned fibres coincide with the Hashin-Rosen bounds of the matrix-based composite for
+    //the axial shear modulus G12 and the plane-strain bulk modulus K23
+    double Em = 3000.;
+    double num = 0.4;
+    double Ef = 70000.;
+    double nuf = 0.3;
+    double cf = 0.2;
+    double cm = 1.-cf;
+    
+    double Gm = Em/(2.*(1.+num));
+    double Gf = Ef/(2.*(1.+nuf));
+    double Km = Em/(2.*(1.+num)*(1.-2.*num));
+    double Kf = Ef/(2.*(1.+nuf)*(1.-2.*nuf));
+    
+    double G12 = Gm + cf/(1./(Gf-Gm) + cm/(2.*Gm));
+    double K23 = Km + cf/(1./(Kf-Km) + cm/(Km+Gm));
+    
+    BOOST_CHECK( fabs(L(3,3) - G12) < 1.E-6*G12 );
+    BOOST_CHECK( fabs(L(4,4) - G12) < 1.E-6*G12 );
+    BOOST_CHECK( fabs(0.5*(L(1,1)+L(1,2)) - K23) < 1.E-6*K23 );
+}
+
+//Reference for the periodic layers: the normal parts of the tangents and the concentration tensors computed on every call from the rotate_* functions,
+//and the strain increments of the sub-phases given by the first localization from the effective strain increment DE_eff
+static void Periodic_Layer_ref(phase_characteristics &phase, const vec &DE_eff, std::vector<mat> &Dnn, std::vector<mat> &A, std::vector<vec> &DEtot) {
+    
+    int nphases = int(phase.sub_phases.size());
+    Dnn.assign(nphases, zeros(3,3));
+    A.assign(nphases, zeros(6,6));
+    DEtot.assign(nphases, DE_eff);
+    std::vector<mat> Dnt(nphases, zeros(3,3));
+    std::vector<vec> sigma_hat(nphases, zeros(3));
+    
+    mat sumDnn = zeros(3,3);
+    mat sumDnt = zeros(3,3);
+    vec sumcDsig = zeros(3);
+    for (int i=0; i<nphases; i++) {
+        layer *lay = phase.sub_phases[i].shape_as<layer>();
+        state_variables_M *sv_r = phase.sub_phases[i].sv_global_as<state_variables_M>();
+        mat Lt_loc = rotate_g2l_L(sv_r->Lt, lay->psi_geom, lay->theta_geom, lay->phi_geom);
+        uvec n = {0, 3, 4};
+        uvec t = {1, 2, 5};
+        Dnn[i] = Lt_loc.submat(n, n);
+        Dnt[i] = Lt_loc.submat(n, t);
+        
+        vec sigma_local = rotate_g2l_stress(sv_r->sigma, lay->psi_geom, lay->theta_geom, lay->phi_geom);
+        sigma_hat[i] = sigma_local.elem(n);
+        
+        sumDnn += lay->concentration*inv(Dnn[i]);
+        sumDnt += lay->concentration*inv(Dnn[i])*Dnt[i];
+        sumcDsig += lay->concentration*inv(Dnn[i])*sigma_hat[i];
+    }
+    mat m_n = inv(sumDnn);
+    mat m_t = m_n*sumDnt;
+    vec m = m_n*sumcDsig;
+    
+    for (int i=0; i<nphases; i++) {
+        layer *lay = phase.sub_phases[i].shape_as<layer>();
+        mat dXn = inv(Dnn[i])*(m_n-Dnn[i]);
+        mat dXt = inv(Dnn[i])*(m_t-Dnt[i]);
+        
+        //The rows 1, 4 and 5 (normal components) of the local concentration tensor are corrected
+        mat A_loc = eye(6,6);
+        int rows[3] = {0, 3, 4};
+        for (int k=0; k<3; k++) {
+            A_loc(rows[k],0) += dXn(k,0);
+            A_loc(rows[k],1) += dXt(k,0);
+            A_loc(rows[k],2) += dXt(k,1);
+            A_loc(rows[k],3) += dXn(k,1);
+            A_loc(rows[k],4) += dXn(k,2);
+            A_loc(rows[k],5) += dXt(k,2);
+        }
+        A[i] = rotate_l2g_A(A_loc, lay->psi_geom, lay->theta_geom, lay->phi_geom);
+        
+        vec dzdx1 = inv(Dnn[i])*(m-sigma_hat[i]);
+        vec dEtot_local = zeros(6);
+        dEtot_local(0) = dzdx1(0);
+        dEtot_local(3) = dzdx1(1);
+        dEtot_local(4) = dzdx1(2);
+        DEtot[i] += rotate_l2g_strain(dEtot_local, lay->psi_geom, lay->theta_geom, lay->phi_geom);
+    }
+}
+
+BOOST_AUTO_TEST_CASE( Periodic_Layer )
+{
+    //Two isotropic layers (E = 3000, nu = 0.4, c = 0.8 and E = 70000, nu = 0.3, c = 0.2), rotated by the geometric angles of data/Nlayers0.dat
+    phase_characteristics rve;
+    vec props = {2, 0};
+    multiphase_rve(rve, "MIPLN", props);
+    get_L_elastic(rve);
+    int nphases = int(rve.sub_phases.size());
+    BOOST_REQUIRE( nphases == 2 );
+    
+    //Arbitrary stresses in the layers and effective strain increment
+    vec DE_eff = {1.E-3, -3.E-4, 5.E-4, 2.E-4, -1.E-4, 3.E-4};
+    rve.sv_local_as<state_variables_M>()->DEtot = DE_eff;
+    rve.sub_phases[0].sptr_sv_global->sigma = {10., -5., 3., 2., 1., -4.};
+    rve.sub_phases[1].sptr_sv_global->sigma = {-20., 8., 15., -6., 4., 9.};
+    
+    std::vector<mat> Dnn_ref;
+    std::vector<mat> A_ref;
+    std::vector<vec> DEtot_ref;
+    for (int n=0; n<2; n++) {
+        
+        Periodic_Layer_ref(rve, DE_eff, Dnn_ref, A_ref, DEtot_ref);
+        Lt_Periodic_Layer(rve);
+        dE_Periodic_Layer(rve, 0);
+        
+        for (int i=0; i<nphases; i++) {
+            layer_multi *lay_multi = rve.sub_phases[i].multi_as<layer_multi>();
+            BOOST_CHECK( norm(lay_multi->Dnn - Dnn_ref[i],2) < 1.E-9*norm(Dnn_ref[i],2) );
+            BOOST_CHECK( norm(lay_multi->A - A_ref[i],2) < 1.E-9*norm(A_ref[i],2) );
+            BOOST_CHECK( norm(rve.sub_phases[i].sptr_sv_global->DEtot - DEtot_ref[i],2) < 1.E-9*norm(DEtot_ref[i],2) );
+        }
+        
+        //The tangent of a layer changes: its cached blocks have to be recomputed
+        rve.sub_phases[1].sv_global_as<state_variables_M>()->Lt *= 2.;
+    }
+}
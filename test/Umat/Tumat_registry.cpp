@@ -0,0 +1,100 @@
+/* This file is part of SMART+.
+ 
+ SMART+ is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ SMART+ is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with SMART+.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+///@file Tumat_registry.cpp
+///@brief Test for the registry of the constitutive laws
+///@version 1.0
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "umat_registry"
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <armadillo>
+#include <smartplus/parameter.hpp>
+#include <smartplus/Libraries/Phase/phase_characteristics.hpp>
+#include <smartplus/Libraries/Phase/state_variables_M.hpp>
+#include <smartplus/Umat/umat_registry.hpp>
+#include <smartplus/Umat/umat_smart.hpp>
+#include <smartplus/Umat/Mechanical/Elasticity/elastic_isotropic.hpp>
+
+using namespace std;
+using namespace arma;
+using namespace smart;
+
+static int ncalls_user = 0;
+
+//User-defined law: isotropic elasticity that counts its calls
+static void umat_elasticity_iso_count(const vec &Etot, const vec &DEtot, vec &sigma, mat &Lt, const mat &DR, const int &nprops, const vec &props, const int &nstatev, vec &statev, const double &T, const double &DT, const double &Time, const double &DTime, double &Wm, double &Wm_r, double &Wm_ir, double &Wm_d, const int &ndi, const int &nshr, const bool &start, double &tnew_dt)
+{
+    ncalls_user++;
+    umat_elasticity_iso(Etot, DEtot, sigma, Lt, DR, nprops, props, nstatev, statev, T, DT, Time, DTime, Wm, Wm_r, Wm_ir, Wm_d, ndi, nshr, start, tnew_dt);
+}
+
+BOOST_AUTO_TEST_CASE( register_umat_user )
+{
+    BOOST_CHECK( find_umat("ELCNT") == umat_unknown );
+    int id = register_umat("ELCNT", umat_elasticity_iso_count);
+    BOOST_CHECK( id >= umat_user );
+    BOOST_CHECK( find_umat("ELCNT") == id );
+    BOOST_CHECK( find_umat_M(id) == umat_elasticity_iso_count );
+    BOOST_CHECK( find_umat_T(id) == NULL );
+    BOOST_CHECK( find_umat_M(find_umat("ELISO")) == umat_elasticity_iso );
+    
+    vec props = {70000., 0.3, 1.E-5};
+    int nstatev = 1;
+    vec DEtot = {1.E-3, -3.E-4, -3.E-4, 2.E-4, 0., 0.};
+    double tnew_dt = 1.;
+    
+    //Single phase through select_umat_M, the user law against ELISO
+    mat sigma_ref = zeros(6,2);
+    string umat_names[2] = {"ELCNT", "ELISO"};
+    for (int k=0; k<2; k++) {
+        phase_characteristics rve;
+        rve.sptr_matprops->update(0, umat_names[k], 1, 0., 0., 0., props.n_elem, props);
+        rve.construct(0,1);
+        rve.sptr_sv_global->update(zeros(6), DEtot, zeros(6), zeros(6), 290., 0., nstatev, zeros(nstatev), zeros(nstatev));
+        select_umat_M(rve, eye(3,3), 0., 1., 3, 3, true, tnew_dt);
+        sigma_ref.col(k) = rve.sptr_sv_global->sigma;
+    }
+    BOOST_CHECK( ncalls_user == 1 );
+    BOOST_CHECK( norm(sigma_ref.col(0) - sigma_ref.col(1),2) < 1.E-9*norm(sigma_ref.col(1),2) );
+    
+    //Batch of points through run_umat_M_batch
+    int npoints = 4;
+    mat Etot = zeros(6, npoints);
+    mat DEtot_batch = zeros(6, npoints);
+    for (int i=0; i<npoints; i++) {
+        DEtot_batch.col(i) = (i+1.)*DEtot;
+    }
+    mat sigma = zeros(6, npoints);
+    cube Lt = zeros(6, 6, npoints);
+    mat statev = zeros(nstatev, npoints);
+    mat Wm = zeros(4, npoints);
+    vec T = 290.*ones(npoints);
+    vec DT = zeros(npoints);
+    cube DR = zeros(3, 3, npoints);
+    for (int i=0; i<npoints; i++) {
+        DR.slice(i) = eye(3,3);
+    }
+    bool start = true;
+    run_umat_M_batch("ELCNT", props, nstatev, 0., 0., 0., Etot, DEtot_batch, sigma, Lt, statev, Wm, T, DT, DR, 0., 1., 3, 3, start, tnew_dt);
+    
+    BOOST_CHECK( ncalls_user == 1 + npoints );
+    for (int i=0; i<npoints; i++) {
+        BOOST_CHECK( norm(sigma.col(i) - (i+1.)*sigma_ref.col(1),2) < 1.E-9*(i+1.)*norm(sigma_ref.col(1),2) );
+    }
+}
@@ -0,0 +1,117 @@
+/* This file is part of SMART+.
+ 
+ SMART+ is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ SMART+ is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with SMART+.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+///@file Tumat_smart.cpp
+///@brief Test for the batched evaluation of the mechanical constitutive laws
+///@version 1.0
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "umat_smart"
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+#include <armadillo>
+#include <smartplus/parameter.hpp>
+#include <smartplus/Libraries/Phase/phase_characteristics.hpp>
+#include <smartplus/Libraries/Phase/state_variables_M.hpp>
+#include <smartplus/Umat/umat_smart.hpp>
+
+using namespace std;
+using namespace arma;
+using namespace smart;
+
+//npoints of an elastic-plastic material (EPICP) driven along different strain paths, point by point with run_umat_M and at once with run_umat_M_batch
+static void check_batch(const double &psi_mat, const double &theta_mat, const double &phi_mat) {
+    
+    string umat_name = "EPICP";
+    vec props = {3000., 0.4, 0., 10., 300., 0.3};
+    int nstatev = 8;
+    int npoints = 3;
+    double T_init = 290.;
+    
+    mat DEtot = zeros(6, npoints);
+    DEtot.col(0) = {2.E-3, -1.E-3, -1.E-3, 0., 0., 0.};
+    DEtot.col(1) = {0., 0., 0., 4.E-3, 0., 0.};
+    DEtot.col(2) = {1.E-3, 5.E-4, -2.E-3, 1.E-3, -5.E-4, 2.E-3};
+    
+    //Points evaluated one by one
+    std::vector<phase_characteristics> rves(npoints);
+    std::vector<bool> start_points(npoints, true);
+    for (int i=0; i<npoints; i++) {
+        rves[i].sptr_matprops->update(0, umat_name, 1, psi_mat, theta_mat, phi_mat, props.n_elem, props);
+        rves[i].construct(0,1);
+        rves[i].sptr_sv_global->update(zeros(6), zeros(6), zeros(6), zeros(6), T_init, 0., nstatev, zeros(nstatev), zeros(nstatev));
+    }
+    
+    //Same points in structure-of-arrays buffers
+    mat Etot = zeros(6, npoints);
+    mat sigma = zeros(6, npoints);
+    cube Lt = zeros(6, 6, npoints);
+    mat statev = zeros(nstatev, npoints);
+    mat Wm = zeros(4, npoints);
+    vec T = T_init*ones(npoints);
+    vec DT = zeros(npoints);
+    cube DR = zeros(3, 3, npoints);
+    for (int i=0; i<npoints; i++) {
+        DR.slice(i) = eye(3,3);
+    }
+    bool start_batch = true;
+    
+    double Time = 0.;
+    double DTime = 0.1;
+    double tnew_dt = 1.;
+    
+    //Ten increments take the paths beyond the yield strain
+    for (int n=0; n<10; n++) {
+        
+        for (int i=0; i<npoints; i++) {
+            auto sv_M = std::dynamic_pointer_cast<state_variables_M>(rves[i].sptr_sv_global);
+            sv_M->Etot = Etot.col(i);
+            sv_M->DEtot = DEtot.col(i);
+            bool start_i = start_points[i];
+            run_umat_M(rves[i], eye(3,3), Time, DTime, 3, 3, start_i, tnew_dt);
+            start_points[i] = start_i;
+        }
+        run_umat_M_batch(umat_name, props, nstatev, psi_mat, theta_mat, phi_mat, Etot, DEtot, sigma, Lt, statev, Wm, T, DT, DR, Time, DTime, 3, 3, start_batch, tnew_dt);
+        
+        for (int i=0; i<npoints; i++) {
+            auto sv_M = std::dynamic_pointer_cast<state_variables_M>(rves[i].sptr_sv_global);
+            BOOST_CHECK( norm(sigma.col(i) - sv_M->sigma,2) < 1.E-9*(1.+norm(sv_M->sigma,2)) );
+            BOOST_CHECK( norm(Lt.slice(i) - sv_M->Lt,2) < 1.E-9*norm(sv_M->Lt,2) );
+            BOOST_CHECK( norm(statev.col(i) - sv_M->statev,2) < 1.E-9*(1.+norm(sv_M->statev,2)) );
+            BOOST_CHECK( norm(Wm.col(i) - sv_M->Wm,2) < 1.E-9*(1.+norm(sv_M->Wm,2)) );
+        }
+        
+        Etot += DEtot;
+        Time += DTime;
+    }
+    
+    //The material has yielded at every point
+    for (int i=0; i<npoints; i++) {
+        BOOST_CHECK( statev(1,i) > 0. );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( run_umat_M_batch_points )
+{
+    check_batch(0., 0., 0.);
+}
+
+BOOST_AUTO_TEST_CASE( run_umat_M_batch_rotated )
+{
+    check_batch(0.3, 0.5, -0.2);
+}